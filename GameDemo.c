@@ -147,6 +147,15 @@ static uint32_t ProblemCreate (RandomObject randomObject, uint32_t gameNumber, N
     return 101 + (RandomGetValue (randomObject) % 899);
 }
 
+// Solve a problem, using the snapshot of its operations if it could be
+// initialized (or solving it from scratch otherwise)
+static NumbersError ProblemSolve (NumbersObject numbersObject, NumbersSnapshotObject snapshotObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result) {
+    if (snapshotObject) {
+        return NumbersSolveSnapshot (snapshotObject, target, complexity, solutionOperations, result);
+    }
+    return NumbersSolve (numbersObject, target, tiles, complexity, solutionOperations, result);
+}
+
 // Compare 2 leaderboard entries
 static uint32_t LeaderboardEntryIsBetterThan (LeaderboardEntry* a, LeaderboardEntry* b, uint32_t target) {
 
@@ -532,9 +541,11 @@ static void OperationHook (NumbersOperation* operation) {
 // Client
 static void Client (struct addrinfo* addressInfo, char* playerName) {
 
-    // Initialize the solver
+    // Initialize the solver (allowing its arrays of operations to grow, since
+    // it records all possible operations of each problem)
+    NumbersOptions numbersOptions = {.operationSize = 25000, .operationIdSize = 15000, .threadCount = 1, .operationGrowth = 25000};
     NumbersObject numbersObject = NULL;
-    NumbersError error = NumbersInitialize (25000, 15000, &numbersObject);
+    NumbersError error = NumbersInitializeWithOptions (&numbersOptions, &numbersObject);
     if (error != Success) {
         DisplayError ("Could not initialize the solver.");
         return;
@@ -549,10 +560,12 @@ static void Client (struct addrinfo* addressInfo, char* playerName) {
         STATE_LEADERBOARD
     } stateCurrent = STATE_INIT, stateNext = STATE_INIT;
 
-    // Game problem
+    // Game problem (and snapshot of all the operations of its tiles, since the
+    // problem is solved several times during a game)
     uint32_t tileValues[TILE_COUNT] = {0};
     NumbersTiles tiles = {COUNT_OF (tileValues), tileValues};
     uint32_t target = 0;
+    NumbersSnapshotObject snapshotObject = NULL;
 
     // Initialize the PRNGs
     RandomObject gameRandom = RandomInitialize ();
@@ -673,6 +686,15 @@ static void Client (struct addrinfo* addressInfo, char* playerName) {
                     // Create the problem
                     target = ProblemCreate (gameRandom, gameNumber, &tiles);
 
+                    // Record all the operations of the problem
+                    if (snapshotObject) {
+                        NumbersSnapshotShutdown (snapshotObject);
+                    }
+                    error = NumbersSnapshotInitialize (numbersObject, &tiles, &snapshotObject);
+                    if (error != Success && error != AbortedError) {
+                        DisplayError ("Could not analyze the problem (it will be solved from scratch every time).");
+                    }
+
                     // Display the problem
                     printf ("\n"
                         "+----------------+\n"
@@ -693,7 +715,10 @@ static void Client (struct addrinfo* addressInfo, char* playerName) {
 
                     // Simulate a real player: define the thinking duration
                     uint16_t problemComplexity = UINT16_MAX;
-                    NumbersSolve (numbersObject, target, &tiles, &problemComplexity, NULL, NULL);
+                    error = ProblemSolve (numbersObject, snapshotObject, target, &tiles, &problemComplexity, NULL, NULL);
+                    if (error != Success) {
+                        problemComplexity = UINT16_MAX;
+                    }
                     uint32_t playerThinkingDifficulty = (problemComplexity > playerComplexity ? problemComplexity - playerComplexity : 0);
                     playerThinkingDuration = 10 + (RandomGetValue (playerRandom) % (10 + playerThinkingDifficulty));
                     break;
@@ -733,8 +758,8 @@ static void Client (struct addrinfo* addressInfo, char* playerName) {
 
                     // Solve the problem
                     uint8_t solutionOperations[tiles.count];
-                    NumbersError error = NumbersSolve (numbersObject, target, &tiles, NULL, solutionOperations, NULL);
-                    if (error == Success || error == AbortedError) {
+                    NumbersError error = ProblemSolve (numbersObject, snapshotObject, target, &tiles, NULL, solutionOperations, NULL);
+                    if (error == Success) {
 
                         // Show the list of operations
                         puts ("\nBest solution\n-------------\n");
@@ -805,7 +830,10 @@ static void Client (struct addrinfo* addressInfo, char* playerName) {
                     // same PRNG seed on all devices so that these bots are the
                     // same for everyone)
                     uint16_t problemComplexity = UINT16_MAX;
-                    NumbersSolve (numbersObject, target, &tiles, &problemComplexity, NULL, NULL);
+                    NumbersError error = ProblemSolve (numbersObject, snapshotObject, target, &tiles, &problemComplexity, NULL, NULL);
+                    if (error != Success) {
+                        problemComplexity = UINT16_MAX;
+                    }
 
                     RandomSetSeed (gameRandom, gameNumber);
                     struct {
@@ -831,15 +859,15 @@ static void Client (struct addrinfo* addressInfo, char* playerName) {
                         uint32_t botThinkingDifficulty = (problemComplexity > botComplexity ? problemComplexity - botComplexity : 0);
                         uint32_t botThinkingDuration = 10 + (RandomGetValue (gameRandom) % (10 + botThinkingDifficulty));
                         if (botThinkingDuration < DURATION_STATE_PLAY) {
-                            NumbersError error = NumbersSolve (numbersObject, target, &tiles, &botComplexity, NULL, &botResult);
-                            if (error != Success && error != AbortedError) {
+                            error = ProblemSolve (numbersObject, snapshotObject, target, &tiles, &botComplexity, NULL, &botResult);
+                            if (error != Success) {
                                 continue;
                             }
                             uint32_t botBonusDuration = DURATION_STATE_PLAY - botThinkingDuration;
                             leaderboardEntry->solutionTiming = botThinkingDuration;
                             leaderboardEntry->bonusPoints = RandomGetValue (gameRandom) % botBonusDuration - botBonusDuration / 3;
                         } else {
-                            NumbersError error = NumbersValidate (target, &tiles, NULL, &botResult, NULL);
+                            error = NumbersValidate (target, &tiles, NULL, &botResult, NULL);
                             if (error != Success) {
                                 continue;
                             }
@@ -933,8 +961,14 @@ static void Client (struct addrinfo* addressInfo, char* playerName) {
                 if (gameTiming >= playerThinkingDuration) {
 
                     // Simulate a real player: solve the problem
+                    // (or keep the best tile if the problem could not be
+                    // solved)
                     uint16_t complexity = playerComplexity;
-                    NumbersSolve (numbersObject, target, &tiles, &complexity, playerData.solutionOperations, &playerResult);
+                    NumbersError error = ProblemSolve (numbersObject, snapshotObject, target, &tiles, &complexity, playerData.solutionOperations, &playerResult);
+                    if (error != Success) {
+                        playerData.solutionOperations[0] = 0;
+                        NumbersValidate (target, &tiles, NULL, &playerResult, NULL);
+                    }
                     playerData.solutionTiming = gameTiming;
                     printf ("\nMy result: %u\n", playerResult);
 
@@ -983,6 +1017,11 @@ static void Client (struct addrinfo* addressInfo, char* playerName) {
     RandomShutdown (playerRandom);
     RandomShutdown (gameRandom);
 
+    // Shut down the snapshot of the last problem
+    if (snapshotObject) {
+        NumbersSnapshotShutdown (snapshotObject);
+    }
+
     // Shut down the solver
     NumbersShutdown (numbersObject);
 }
@@ -13,11 +13,15 @@
 // Benchmark data
 static struct {
     uint32_t workerCount;
+    uint32_t solverThreadCount;
+    uint32_t disableResultHash;
+    uint32_t disableComplexity;
     uint32_t tileCount;
     enum {
         IMPOSSIBLE_TARGET,
         RANDOM_TARGET,
-        ALL_TARGETS
+        ALL_TARGETS,
+        RANGE_TARGETS
     } targetType;
 } benchmarkData;
 
@@ -82,6 +86,11 @@ static void CombinationGenerateAll (void) {
     uint32_t combinationCount = 0;
     uint32_t pairCount = benchmarkData.tileCount >> 1;
     do {
+
+        // Make sure the set has enough distinct values for the unpaired tiles
+        if (benchmarkData.tileCount - (pairCount << 1) > sizeof (tileSet) / sizeof (tileSet[0])) {
+            continue;
+        }
         uint32_t pairGroup = (1 << pairCount) - 1;
         do {
 
@@ -174,9 +183,20 @@ static void* Worker (void* data) {
     workerData->errorCount = 0;
     workerData->complexityMax = 0;
 
-    // Initialize the solver
+    // Initialize the solver (letting its arrays grow when there are more than
+    // 8 tiles or when solving a range of targets, since it would always abort
+    // its search otherwise)
     NumbersObject numbersObject = NULL;
-    NumbersError error = NumbersInitialize (25000, 15000, &numbersObject);
+    uint32_t operationGrowth = benchmarkData.tileCount > 8 || benchmarkData.targetType == RANGE_TARGETS ? 25000 : 0;
+    NumbersOptions options = {
+        .operationSize = 25000,
+        .operationIdSize = 15000,
+        .threadCount = benchmarkData.solverThreadCount,
+        .operationGrowth = operationGrowth,
+        .disableResultHash = benchmarkData.disableResultHash,
+        .disableComplexity = benchmarkData.disableComplexity
+    };
+    NumbersError error = NumbersInitializeWithOptions (&options, &numbersObject);
     if (error != Success) {
         puts ("Error: Could not initialize the solver.");
         pthread_exit ((void*)-1);
@@ -192,7 +212,8 @@ static void* Worker (void* data) {
 
     // Define the solution (even though it will not be displayed, it matters
     // for the benchmark)
-    uint8_t solutionOperations[benchmarkData.tileCount];
+    uint16_t solutionOperations[benchmarkData.tileCount];
+    NumbersSolution solutions[999 - 101 + 1];
 
     // Work!
     while (1) {
@@ -216,7 +237,7 @@ static void* Worker (void* data) {
 
         // Set a target for this combination
         uint32_t target;
-        if (benchmarkData.targetType == ALL_TARGETS) {
+        if (benchmarkData.targetType == ALL_TARGETS || benchmarkData.targetType == RANGE_TARGETS) {
             target = 101;
         } else if (benchmarkData.targetType == RANDOM_TARGET) {
             target = 101 + (RandomGetValue (randomObject) % 899);
@@ -228,10 +249,22 @@ static void* Worker (void* data) {
             // Define the complexity
             uint16_t complexity = UINT16_MAX;
 
-            // Solve the game
+            // Solve the game (for all targets at once, if applicable)
             uint64_t duration = TimeGet ();
-            error = NumbersSolve (numbersObject, target, &tiles, &complexity, solutionOperations, NULL);
+            if (benchmarkData.targetType == RANGE_TARGETS) {
+                error = NumbersSolveRange (numbersObject, target, 999, &tiles, complexity, solutions);
+            } else {
+                error = NumbersSolveExtended (numbersObject, target, &tiles, &complexity, solutionOperations, NULL);
+            }
             duration = TimeGet () - duration;
+            if (benchmarkData.targetType == RANGE_TARGETS) {
+                complexity = 0;
+                for (uint32_t solutionId = 0; solutionId < 999 - 101 + 1; ++solutionId) {
+                    if (complexity < solutions[solutionId].complexity) {
+                        complexity = solutions[solutionId].complexity;
+                    }
+                }
+            }
 
             // Record data
             workerData->durationTotal += duration;
@@ -272,7 +305,7 @@ static void* Worker (void* data) {
 // Display the usage
 static void UsageDisplay (char* name) {
     printf ("Usage:\n"
-        "%s [<thread count (1-32)> [<tile count (0-8)> [impossible | random | all]]]\n",
+        "%s [<thread count (1-32)> [<tile count (0-16)> [impossible | random | all | range [<solver thread count (1-32)> [hash | direct [fast | complexity]]]]]]\n",
         name);
 }
 
@@ -294,7 +327,7 @@ static int ArgumentsCheck (int argc, char** argv) {
         return 0;
     }
     benchmarkData.tileCount = StringToNumber (argv[2], &argEnd);
-    if (*argEnd != '\0' || benchmarkData.tileCount > 8) {
+    if (*argEnd != '\0' || benchmarkData.tileCount > NUMBERS_TILE_COUNT_MAX) {
         return -1;
     }
 
@@ -308,14 +341,49 @@ static int ArgumentsCheck (int argc, char** argv) {
         benchmarkData.targetType = RANDOM_TARGET;
     } else if (!strcmp (argv[3], "all")) {
         benchmarkData.targetType = ALL_TARGETS;
+    } else if (!strcmp (argv[3], "range")) {
+        benchmarkData.targetType = RANGE_TARGETS;
     } else {
         return -1;
     }
 
-    // Check whether there is a fourth argument
+    // Check the fourth argument
     if (argc <= 4) {
         return 0;
     }
+    benchmarkData.solverThreadCount = StringToNumber (argv[4], &argEnd);
+    if (*argEnd != '\0' || benchmarkData.solverThreadCount < 1 || benchmarkData.solverThreadCount > 32) {
+        return -1;
+    }
+
+    // Check the fifth argument
+    if (argc <= 5) {
+        return 0;
+    }
+    if (!strcmp (argv[5], "hash")) {
+        benchmarkData.disableResultHash = 0;
+    } else if (!strcmp (argv[5], "direct")) {
+        benchmarkData.disableResultHash = 1;
+    } else {
+        return -1;
+    }
+
+    // Check the sixth argument
+    if (argc <= 6) {
+        return 0;
+    }
+    if (!strcmp (argv[6], "fast")) {
+        benchmarkData.disableComplexity = 1;
+    } else if (!strcmp (argv[6], "complexity")) {
+        benchmarkData.disableComplexity = 0;
+    } else {
+        return -1;
+    }
+
+    // Check whether there is a seventh argument
+    if (argc <= 7) {
+        return 0;
+    }
     return -1;
 }
 
@@ -327,6 +395,9 @@ int main (int argc, char** argv) {
 
     // Check the arguments
     benchmarkData.workerCount = 4;
+    benchmarkData.solverThreadCount = 1;
+    benchmarkData.disableResultHash = 0;
+    benchmarkData.disableComplexity = 1;
     benchmarkData.tileCount = 6;
     benchmarkData.targetType = IMPOSSIBLE_TARGET;
     if (ArgumentsCheck (argc, argv)) {
@@ -400,17 +471,6 @@ int main (int argc, char** argv) {
     pthread_cond_destroy (&combinationData.generate);
     pthread_mutex_destroy (&combinationData.mutex);
 
-    // Determine whether the solver supports complexity check or not
-    uint16_t complexityCheck = UINT16_MAX;
-    NumbersObject numbersObject = NULL;
-    NumbersError numbersError = NumbersInitialize (4, 1, &numbersObject);
-    if (numbersError == Success) {
-        uint32_t tileValues[] = {2, 2};
-        NumbersTiles tiles = {2, tileValues};
-        numbersError = NumbersSolve (numbersObject, 4, &tiles, &complexityCheck, NULL, NULL);
-        NumbersShutdown (numbersObject);
-    }
-
     // Get the time
     durationReal = TimeGet () - durationReal;
 
@@ -420,23 +480,21 @@ int main (int argc, char** argv) {
         solverCallCount, solverCallCount > 1 ? "s" : "",
         abortedCount, abortedCount > 1 ? "s" : "",
         errorCount, errorCount > 1 ? "s" : "");
-    if (numbersError != Success) {
-        puts ("Error: Could not determine whether \"NumbersLibrary\" supports complexity check or not.");
-    } else {
-        printf ("The solver %s complexity check", complexityCheck ? "supports" : "does NOT support");
-        if (benchmarkData.targetType != IMPOSSIBLE_TARGET) {
-            printf (" (max. complexity: %hu)", complexityMax);
-        }
-        puts (".");
+    printf ("The solver %s complexity check", benchmarkData.disableComplexity ? "does NOT support" : "supports");
+    if (!benchmarkData.disableComplexity && benchmarkData.targetType != IMPOSSIBLE_TARGET) {
+        printf (" (max. complexity: %hu)", complexityMax);
     }
+    puts (".");
     printf (
-        "Test duration: %.3f s (i.e. an average of %" PRIu64 " us per %s with %u thread%s, including the test structure overhead).\n"
+        "Test duration: %.3f s (i.e. an average of %" PRIu64 " us per %s with %u thread%s, %u per solver, %s deduplication, including the test structure overhead).\n"
         "Average duration to %s: %" PRIu64 " us (min.: %" PRIu64 " us, max.: %" PRIu64 " us).\n",
         durationReal / 1000000.0f,
         solverCallCount ? durationReal / solverCallCount : 0,
-        benchmarkData.targetType != IMPOSSIBLE_TARGET ? "game" : "combination",
+        benchmarkData.targetType == RANGE_TARGETS ? "range of targets" : benchmarkData.targetType != IMPOSSIBLE_TARGET ? "game" : "combination",
         benchmarkData.workerCount, benchmarkData.workerCount > 1 ? "s" : "",
-        benchmarkData.targetType != IMPOSSIBLE_TARGET ? "solve the game" : "analyze all solutions of a combination",
+        benchmarkData.solverThreadCount,
+        benchmarkData.disableResultHash ? "direct" : "hash",
+        benchmarkData.targetType == RANGE_TARGETS ? "solve the game for all targets" : benchmarkData.targetType != IMPOSSIBLE_TARGET ? "solve the game" : "analyze all solutions of a combination",
         solverCallCount ? durationTotal / solverCallCount : 0,
         solverCallCount ? durationMin : 0,
         durationMax);
@@ -2,10 +2,149 @@
 
 // C libraries
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// Variants of the library (see NumbersLibraryWithoutComplexity.c,
+// NumbersLibrarySse42.c, NumbersLibraryAvx2.c...): each of them is compiled
+// from this source, its functions getting renamed after it so that all
+// variants can be linked together (the complete library picks the variant
+// that suits the options and the processor when initializing an object)
+#ifdef NUMBERS_VARIANT
+#define VARIANT_NAME_PASTE(name, variant) name##variant
+#define VARIANT_NAME(name, variant) VARIANT_NAME_PASTE (name, variant)
+#define NumbersInitialize VARIANT_NAME (NumbersInitialize, NUMBERS_VARIANT)
+#define NumbersInitializeWithOptions VARIANT_NAME (NumbersInitializeWithOptions, NUMBERS_VARIANT)
+#define NumbersShutdown VARIANT_NAME (NumbersShutdown, NUMBERS_VARIANT)
+#define NumbersSolve VARIANT_NAME (NumbersSolve, NUMBERS_VARIANT)
+#define NumbersSolveExtended VARIANT_NAME (NumbersSolveExtended, NUMBERS_VARIANT)
+#define NumbersSolveWithLimits VARIANT_NAME (NumbersSolveWithLimits, NUMBERS_VARIANT)
+#define NumbersGetStatistics VARIANT_NAME (NumbersGetStatistics, NUMBERS_VARIANT)
+#define NumbersSolveRange VARIANT_NAME (NumbersSolveRange, NUMBERS_VARIANT)
+#define NumbersSolveTop VARIANT_NAME (NumbersSolveTop, NUMBERS_VARIANT)
+#define NumbersSolvePareto VARIANT_NAME (NumbersSolvePareto, NUMBERS_VARIANT)
+#define NumbersSelectPareto VARIANT_NAME (NumbersSelectPareto, NUMBERS_VARIANT)
+#define NumbersCacheInitialize VARIANT_NAME (NumbersCacheInitialize, NUMBERS_VARIANT)
+#define NumbersCacheShutdown VARIANT_NAME (NumbersCacheShutdown, NUMBERS_VARIANT)
+#define NumbersSolveCached VARIANT_NAME (NumbersSolveCached, NUMBERS_VARIANT)
+#define NumbersSnapshotInitialize VARIANT_NAME (NumbersSnapshotInitialize, NUMBERS_VARIANT)
+#define NumbersSnapshotShutdown VARIANT_NAME (NumbersSnapshotShutdown, NUMBERS_VARIANT)
+#define NumbersSolveSnapshot VARIANT_NAME (NumbersSolveSnapshot, NUMBERS_VARIANT)
+#define NumbersBatchInitialize VARIANT_NAME (NumbersBatchInitialize, NUMBERS_VARIANT)
+#define NumbersBatchShutdown VARIANT_NAME (NumbersBatchShutdown, NUMBERS_VARIANT)
+#define NumbersSolveBatch VARIANT_NAME (NumbersSolveBatch, NUMBERS_VARIANT)
+#define NumbersPoolInitialize VARIANT_NAME (NumbersPoolInitialize, NUMBERS_VARIANT)
+#define NumbersPoolShutdown VARIANT_NAME (NumbersPoolShutdown, NUMBERS_VARIANT)
+#define NumbersPoolAcquire VARIANT_NAME (NumbersPoolAcquire, NUMBERS_VARIANT)
+#define NumbersPoolRelease VARIANT_NAME (NumbersPoolRelease, NUMBERS_VARIANT)
+#define NumbersShuffle VARIANT_NAME (NumbersShuffle, NUMBERS_VARIANT)
+#define NumbersValidate VARIANT_NAME (NumbersValidate, NUMBERS_VARIANT)
+#define NumbersValidateExtended VARIANT_NAME (NumbersValidateExtended, NUMBERS_VARIANT)
+#define NumbersValidateBatch VARIANT_NAME (NumbersValidateBatch, NUMBERS_VARIANT)
+#endif
 
 // Numbers library
 #include "NumbersLibrary.h"
 
+#ifndef NUMBERS_VARIANT
+// Initialization functions of the variants of the library
+extern NumbersError NumbersInitializeWithOptionsWithoutComplexity (NumbersOptions* options, NumbersObject* numbersObject);
+extern NumbersError NumbersInitializeWithOptionsCheckOverflow (NumbersOptions* options, NumbersObject* numbersObject);
+extern NumbersError NumbersInitializeWithOptionsCheckOverflowWithoutComplexity (NumbersOptions* options, NumbersObject* numbersObject);
+extern NumbersError NumbersInitializeWithOptionsStatistics (NumbersOptions* options, NumbersObject* numbersObject);
+extern NumbersError NumbersInitializeWithOptionsStatisticsWithoutComplexity (NumbersOptions* options, NumbersObject* numbersObject);
+#if defined(__x86_64__) || defined(__i386__)
+extern NumbersError NumbersInitializeWithOptionsSse42 (NumbersOptions* options, NumbersObject* numbersObject);
+extern NumbersError NumbersInitializeWithOptionsSse42WithoutComplexity (NumbersOptions* options, NumbersObject* numbersObject);
+extern NumbersError NumbersInitializeWithOptionsAvx2 (NumbersOptions* options, NumbersObject* numbersObject);
+extern NumbersError NumbersInitializeWithOptionsAvx2WithoutComplexity (NumbersOptions* options, NumbersObject* numbersObject);
+#endif
+#endif
+
+// Vector instructions (used to combine a result with a block of results at
+// once, unless overflows are checked, which only the scalar code does)
+#if defined(__AVX2__) && !defined(CHECK_OVERFLOW)
+#include <immintrin.h>
+#define VECTOR_WIDTH 8
+typedef __m256i Vector;
+#define VectorSet(value) _mm256_set1_epi32 (value)
+#define VectorLoad(values) _mm256_loadu_si256 ((__m256i*)(values))
+#define VectorLoadComplexities(complexities) _mm256_cvtepu16_epi32 (_mm_loadu_si128 ((__m128i*)(complexities)))
+#define VectorLoadWeights(weights) _mm256_cvtepu8_epi32 (_mm_loadl_epi64 ((__m128i*)(weights)))
+#define VectorStore(values, vector) _mm256_storeu_si256 ((__m256i*)(values), vector)
+#define VectorAdd(a, b) _mm256_add_epi32 (a, b)
+#define VectorSub(a, b) _mm256_sub_epi32 (a, b)
+#define VectorMul(a, b) _mm256_mullo_epi32 (a, b)
+#define VectorMax(a, b) _mm256_max_epu32 (a, b)
+#define VectorMin(a, b) _mm256_min_epu32 (a, b)
+#define VectorShiftRight(a, count) _mm256_srli_epi32 (a, count)
+#define VectorAnd(a, b) _mm256_and_si256 (a, b)
+#define VectorAndNot(a, b) _mm256_andnot_si256 (a, b)
+#define VectorOr(a, b) _mm256_or_si256 (a, b)
+#define VectorNot(a) _mm256_xor_si256 (a, _mm256_set1_epi32 (-1))
+#define VectorEqual(a, b) _mm256_cmpeq_epi32 (a, b)
+#define VectorGreater(a, b) _mm256_cmpgt_epi32 (a, b)
+#define VectorBlend(a, b, mask) _mm256_blendv_epi8 (a, b, mask)
+#define VectorMask(a) _mm256_movemask_ps (_mm256_castsi256_ps (a))
+
+// Divide unsigned integers (using double precision floating point numbers,
+// which is exact enough to check whether the division is exact afterwards)
+inline static Vector VectorDivide (Vector dividend, Vector divisor) {
+    __m256i sign = _mm256_set1_epi32 (INT32_MIN);
+    __m256d offset = _mm256_set1_pd (-(double)INT32_MIN);
+    dividend = _mm256_xor_si256 (dividend, sign);
+    divisor = _mm256_xor_si256 (divisor, sign);
+    __m256d dividendLow = _mm256_add_pd (_mm256_cvtepi32_pd (_mm256_castsi256_si128 (dividend)), offset);
+    __m256d dividendHigh = _mm256_add_pd (_mm256_cvtepi32_pd (_mm256_extracti128_si256 (dividend, 1)), offset);
+    __m256d divisorLow = _mm256_add_pd (_mm256_cvtepi32_pd (_mm256_castsi256_si128 (divisor)), offset);
+    __m256d divisorHigh = _mm256_add_pd (_mm256_cvtepi32_pd (_mm256_extracti128_si256 (divisor, 1)), offset);
+    return _mm256_set_m128i (
+        _mm256_cvttpd_epi32 (_mm256_div_pd (dividendHigh, divisorHigh)),
+        _mm256_cvttpd_epi32 (_mm256_div_pd (dividendLow, divisorLow)));
+}
+#elif defined(__SSE4_2__) && !defined(CHECK_OVERFLOW)
+#include <nmmintrin.h>
+#define VECTOR_WIDTH 4
+typedef __m128i Vector;
+#define VectorSet(value) _mm_set1_epi32 (value)
+#define VectorLoad(values) _mm_loadu_si128 ((__m128i*)(values))
+#define VectorLoadComplexities(complexities) _mm_cvtepu16_epi32 (_mm_loadl_epi64 ((__m128i*)(complexities)))
+#define VectorLoadWeights(weights) _mm_cvtepu8_epi32 (_mm_cvtsi32_si128 (*(int32_t*)(weights)))
+#define VectorStore(values, vector) _mm_storeu_si128 ((__m128i*)(values), vector)
+#define VectorAdd(a, b) _mm_add_epi32 (a, b)
+#define VectorSub(a, b) _mm_sub_epi32 (a, b)
+#define VectorMul(a, b) _mm_mullo_epi32 (a, b)
+#define VectorMax(a, b) _mm_max_epu32 (a, b)
+#define VectorMin(a, b) _mm_min_epu32 (a, b)
+#define VectorShiftRight(a, count) _mm_srli_epi32 (a, count)
+#define VectorAnd(a, b) _mm_and_si128 (a, b)
+#define VectorAndNot(a, b) _mm_andnot_si128 (a, b)
+#define VectorOr(a, b) _mm_or_si128 (a, b)
+#define VectorNot(a) _mm_xor_si128 (a, _mm_set1_epi32 (-1))
+#define VectorEqual(a, b) _mm_cmpeq_epi32 (a, b)
+#define VectorGreater(a, b) _mm_cmpgt_epi32 (a, b)
+#define VectorBlend(a, b, mask) _mm_blendv_epi8 (a, b, mask)
+#define VectorMask(a) _mm_movemask_ps (_mm_castsi128_ps (a))
+
+// Divide unsigned integers (using double precision floating point numbers,
+// which is exact enough to check whether the division is exact afterwards)
+inline static Vector VectorDivide (Vector dividend, Vector divisor) {
+    __m128i sign = _mm_set1_epi32 (INT32_MIN);
+    __m128d offset = _mm_set1_pd (-(double)INT32_MIN);
+    dividend = _mm_xor_si128 (dividend, sign);
+    divisor = _mm_xor_si128 (divisor, sign);
+    __m128d dividendLow = _mm_add_pd (_mm_cvtepi32_pd (dividend), offset);
+    __m128d dividendHigh = _mm_add_pd (_mm_cvtepi32_pd (_mm_shuffle_epi32 (dividend, 0xEE)), offset);
+    __m128d divisorLow = _mm_add_pd (_mm_cvtepi32_pd (divisor), offset);
+    __m128d divisorHigh = _mm_add_pd (_mm_cvtepi32_pd (_mm_shuffle_epi32 (divisor, 0xEE)), offset);
+    return _mm_unpacklo_epi64 (
+        _mm_cvttpd_epi32 (_mm_div_pd (dividendLow, divisorLow)),
+        _mm_cvttpd_epi32 (_mm_div_pd (dividendHigh, divisorHigh)));
+}
+#endif
+
 // Boolean
 typedef enum {
     FALSE = 0,
@@ -21,91 +160,812 @@ typedef enum {
     NOP
 } Operator;
 
-// Operations
+// Operation IDs
+#ifndef ENABLE_16BIT_OPERATION_IDS
+typedef uint32_t OperationId;
+#define OPERATION_ID_NONE UINT32_MAX
+#else
+typedef uint16_t OperationId;
+#define OPERATION_ID_NONE UINT16_MAX
+#endif
+
+// Initial size of the hash sets of operation IDs (must be a power of 2; they
+// double in size whenever more than half of their slots are used by a group
+// of operations)
+#define OPERATION_HASH_SIZE_MIN 1024
+
+// Hash a result (Fibonacci hashing)
+#define OPERATION_HASH(result) ((uint32_t)(result) * 2654435769U)
+
+// Minimum number of results of the smallest group of operations for the final
+// layer to search the results of the largest group instead of combining them
+// with all the results of the smallest one
+#define SORTED_GROUP_SIZE_MIN 2
+
+// Origins of operations (i.e. how their results were obtained)
 typedef struct {
-    uint16_t operationIdLeft;
-    uint16_t operationIdRight;
-    uint32_t result;
+    OperationId operationIdLeft;
+    OperationId operationIdRight;
     uint8_t op;
+} OperationOrigin;
+
+// Operations, stored as a structure of arrays: the results (as well as their
+// complexities and weights) are read over and over when combining groups of
+// operations, while their origins are only needed to generate the solution
+typedef struct {
+    uint32_t* results;
 #ifndef DISABLE_COMPLEXITY
-    uint8_t weight;
-    uint16_t complexity;
+    uint16_t* complexities;
+    uint8_t* weights;
 #endif
-} Operation;
+    OperationOrigin* origins;
+} Operations;
 
-// Groups of operations
+// Groups of operations (in the final layer, the results of some groups get
+// sorted, so that they can be searched rather than combined one by one; the
+// lowest complexity of their operations tells whether combining them could
+// reach the target with a lower complexity than the solution)
 typedef struct {
-    uint16_t operationIdFirst;
-    uint16_t operationIdLast;
+    OperationId operationIdFirst;
+    OperationId operationIdLast;
+    Bool sorted;
+#ifndef DISABLE_COMPLEXITY
+    uint16_t complexityMin;
+#endif
 } OperationGroup;
 
+// Solutions
+typedef struct {
+    OperationId operationId;
+    uint32_t targetDiff;
+    uint32_t tileCount;
+#ifndef DISABLE_COMPLEXITY
+    uint16_t complexity;
+#endif
+    Bool aborted;
+} Solution;
+
+// Candidates for the targets of a range (operation giving a result, and
+// number of tiles it uses)
+typedef struct {
+    OperationId operationId;
+    uint32_t tileCount;
+} RangeCandidate;
+
+// Candidates for the best solutions (operation giving a result, distance
+// between this result and the target, complexity, and number of tiles used)
+typedef struct {
+    OperationId operationId;
+    uint32_t targetDiff;
+    uint16_t complexity;
+    uint16_t tileCount;
+} TopCandidate;
+
+// Maximum number of tiles of the groups whose plans to break them into 2
+// smaller groups are computed once (plans of larger groups are computed
+// whenever needed), and total size of these plans (i.e. the sum of
+// 2^(N - 1) - 1 over all groups of N tiles, N >= 2)
+#define SPLIT_PLAN_TILE_COUNT_MAX 8
+#define SPLIT_PLAN_SIZE 3025
+
+// Plans to break groups of tiles into 2 smaller groups (the plan of each group
+// of tiles starts at a given offset in the array of smaller groups)
+static struct {
+    pthread_once_t once;
+    uint16_t offsets[1 << SPLIT_PLAN_TILE_COUNT_MAX];
+    uint16_t tileSubGroups[SPLIT_PLAN_SIZE];
+} splitPlans = {PTHREAD_ONCE_INIT};
+
+// Check whether an addition or a multiplication overflows (only when the
+// library is built with CHECK_OVERFLOW, so that the standard game, which
+// never overflows, doesn't pay for it; otherwise results wrap around)
+#ifdef CHECK_OVERFLOW
+#define IsAdditionOverflowing(a, b) ((uint32_t)((a) + (b)) < (a))
+#define IsMultiplicationOverflowing(a, b) ((uint64_t)(a) * (b) > UINT32_MAX)
+#else
+#define IsAdditionOverflowing(a, b) FALSE
+#define IsMultiplicationOverflowing(a, b) FALSE
+#endif
+
+// Count some events of the search (only in the variants of the library built
+// with ENABLE_STATISTICS, see NumbersLibraryStatistics.c, so that searches
+// don't pay for it otherwise)
+#ifdef ENABLE_STATISTICS
+#define StatisticsAdd(context, counter, count) ((context)->statistics.counter += (count))
+#else
+#define StatisticsAdd(context, counter, count)
+#endif
+
+// Search contexts (the object records its operations through its own context,
+// while each worker thread records operations through a context of its own)
+typedef struct {
+
+    // Numbers library object
+    NumbersObject numbersObject;
+
+    // Best solution found in this context
+    Solution solution;
+
+    // Best operation found in the final layer (its operation only gets
+    // recorded once the layer has been combined: until then, the solution
+    // refers to the operation recorded before, kept in solutionRecorded)
+    struct {
+        Bool pending;
+        Solution solutionRecorded;
+        uint32_t result;
+        OperationOrigin origin;
+    } final;
+
+    // Current values
+    struct {
+        OperationId operationIdFirst;
+        OperationId operationIdLast;
+        OperationId operationIdLeft;
+        OperationId operationIdRight;
+    } current;
+
+    // Operation IDs (to search for an existing result in the last operation
+    // group)
+    uint32_t operationIdSize;
+    OperationId* operationIds;
+
+    // Hash set of operation IDs (to search for an existing result in the last
+    // operation group when the result is too large for the array of operation
+    // IDs; slots holding the ID of an operation outside of this group are
+    // considered empty, so that the set never needs to be cleared between
+    // groups)
+    uint32_t operationHashSize;
+    uint32_t operationHashCount;
+    OperationId operationHashGroup;
+    OperationId* operationHashes;
+
+    // Operations (the first operation of the arrays has the ID
+    // operationIdBase, and the arrays have room for operationSize operations)
+    OperationId operationIdBase;
+    uint32_t operationSize;
+    Operations operations;
+
+#ifdef ENABLE_STATISTICS
+    // Events counted during the search (see NumbersGetStatistics)
+    struct {
+        uint64_t duplicateHits;
+        uint64_t duplicateMisses;
+        uint64_t outsideResults;
+        uint64_t complexityPruned;
+    } statistics;
+#endif
+} Context;
+
+// Work items (range of sub groups of tiles to be combined by a worker thread)
+typedef struct {
+    uint32_t tileGroup;
+    uint32_t tileSubGroupIdFirst;
+    uint32_t tileSubGroupIdLast;
+    uint32_t workerId;
+    OperationId operationIdFirst;
+    OperationId operationIdLast;
+    Solution solution;
+} WorkItem;
+
+// Worker threads
+typedef struct {
+    uint32_t workerId;
+    pthread_t thread;
+    Context context;
+} Worker;
+
+// Functions of a variant of the library that deal with objects
+typedef struct {
+    NumbersError (*shutdown) (NumbersObject numbersObject);
+    NumbersError (*solve) (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result);
+    NumbersError (*solveExtended) (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint16_t* solutionOperations, uint32_t* result);
+    NumbersError (*solveWithLimits) (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, NumbersLimits* limits, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result);
+    NumbersError (*getStatistics) (NumbersObject numbersObject, NumbersStatistics* statistics);
+    NumbersError (*solveRange) (NumbersObject numbersObject, uint32_t targetFirst, uint32_t targetLast, NumbersTiles* tiles, uint16_t complexityMax, NumbersSolution* solutions);
+    NumbersError (*solveTop) (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t complexityMax, uint32_t solutionCountMax, NumbersSolution* solutions, uint32_t* solutionCount);
+    NumbersError (*solvePareto) (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint32_t solutionCountMax, NumbersSolution* solutions, uint32_t* solutionCount);
+    NumbersError (*snapshotInitialize) (NumbersObject numbersObject, NumbersTiles* tiles, NumbersSnapshotObject* snapshotObject);
+} Variant;
+
+// Functions of this variant of the library
+static const Variant variant;
+
 // Library object
 struct NumbersStruct {
 
-    // Target number and count of tiles
+    // Variant of the library that initialized the object (this must remain
+    // the first member of the object, which layout depends on the variant),
+    // whether this variant tracks complexity, and whether it checks overflows
+    const Variant* variant;
+    Bool complexityDisabled;
+    Bool overflowChecked;
+
+    // Target number and count of tiles (as well as the count of tiles of the
+    // layer in which results that can't beat the best solution are discarded,
+    // which is 0 when all results are needed)
     struct {
         uint32_t target;
         uint32_t tileCount;
+        uint32_t tileCountPruning;
     } final;
 
-    // Solution
-    struct {
-        uint16_t operationId;
-        uint32_t targetDiff;
-        uint32_t tileCount;
-        uint8_t* operations;
-        Bool aborted;
-    } solution;
-
     // Current values
     struct {
         uint32_t tileCount;
 #ifndef DISABLE_COMPLEXITY
         uint16_t complexityMax;
 #endif
-        uint16_t operationIdFirst;
-        uint16_t operationIdLast;
-        uint16_t operationIdLeft;
-        uint16_t operationIdRight;
     } current;
 
-    // Operation IDs (to search for an existing result in the last operation
-    // group)
-    uint16_t operationIdSize;
-    uint16_t* operationIds;
+    // Equal tiles (group of the tiles having the same value as a tile with a
+    // lower ID, and for each tile, group of all tiles having its value): groups
+    // of tiles that only differ by equal tiles share the same operations
+    struct {
+        uint32_t tileGroup;
+        uint32_t tileGroups[NUMBERS_TILE_COUNT_MAX];
+    } duplicates;
+
+    // Context of the object (its arrays hold all the operations of the
+    // previous layers, and operations are recorded directly in them when not
+    // using worker threads)
+    Context context;
+
+    // Worker threads (to combine the groups of operations of a layer in
+    // parallel; the thread calling NumbersSolve acts as the first worker)
+    struct {
+        uint32_t workerCount;
+        Worker* workers;
+        pthread_mutex_t mutex;
+        pthread_cond_t start;
+        pthread_cond_t done;
+        uint32_t generation;
+        uint32_t busyCount;
+        Bool shutdown;
+        OperationGroup* operationGroups;
+        WorkItem* items;
+        uint32_t itemCount;
+        atomic_uint itemNext;
+        atomic_uint itemOver;
+    } threads;
+
+    // Number of operations to add to the arrays of operations when they are
+    // full (or 0 to abort the search instead)
+    uint32_t operationGrowth;
+
+    // Limits of the search (deadline on the monotonic clock in nanoseconds,
+    // budget of pairs of operations to combine, and cancellation flag, each of
+    // them being ignored when 0), pairs of operations combined so far, and
+    // whether any limit got exceeded (see NumbersSolveWithLimits)
+    struct {
+        Bool enabled;
+        uint64_t deadline;
+        uint64_t operationBudget;
+        volatile uint32_t* cancel;
+        atomic_ullong operationCount;
+        atomic_bool exceeded;
+    } limits;
+
+    // Statistics of the last search (see NumbersGetStatistics)
+    NumbersStatistics statistics;
+
+    // Groups of operations (1 group per combination of tiles) and work items
+    // of the worker threads (at most 1 item per combination of tiles), both
+    // allocated for up to tileCountMax tiles
+    uint32_t tileCountMax;
+    OperationGroup* operationGroups;
+    WorkItem* items;
+
+    // Sorted operations (each of them is stored as its result in the upper 32
+    // bits and its ID in the lower 32 bits, at the position given by its ID, so
+    // that each group of operations can be sorted in place) and buffer to sort
+    // them, both with room for size operations
+    struct {
+        uint32_t size;
+        uint64_t* operations;
+        uint64_t* buffer;
+    } sorted;
+};
+
+// Number of shards of a cache (each shard has its own lock, so that threads
+// accessing different shards don't wait for each other) and number of entries
+// per set (a problem can be recorded in any entry of its set)
+#define CACHE_SHARD_COUNT 16
+#define CACHE_WAY_COUNT 4
+
+// Cache entries (problems are recorded with their tiles sorted, the solution
+// referring to the sorted tiles)
+typedef struct {
+    Bool used;
+    uint32_t age;
+    uint32_t hash;
+    uint32_t target;
+    uint16_t complexityMax;
+    uint16_t complexity;
+    Bool complexityDisabled;
+    Bool overflowChecked;
+    uint32_t tileCount;
+    uint32_t tileValues[8];
+    uint32_t result;
+    uint8_t solutionOperations[8];
+} CacheEntry;
+
+// Cache shards
+typedef struct {
+    pthread_mutex_t mutex;
+    uint32_t age;
+    CacheEntry* entries;
+} CacheShard;
+
+// Cache object
+struct NumbersCacheStruct {
+    uint32_t setCount;
+    CacheShard shards[CACHE_SHARD_COUNT];
+};
+
+// Operations of a snapshot (sorted by result, then by number of tiles, then by
+// complexity, so that the first operation with a given result that doesn't
+// exceed the maximum complexity is the best one)
+typedef struct {
+    uint32_t result;
+    uint16_t complexity;
+    uint16_t tileCount;
+    OperationId operationId;
+} SnapshotOperation;
+
+// Snapshot object (its origins of operations are indexed by operation ID, as
+// in the context of the Numbers library object that recorded them)
+struct NumbersSnapshotStruct {
+    uint32_t duplicateTileGroups[8];
+    OperationOrigin* origins;
+    uint32_t operationCount;
+    SnapshotOperation* operations;
+};
+
+// Number of problems taken at once by a thread of a batch object
+#define BATCH_PROBLEM_GRAIN 8
+
+// Threads of a batch object (each thread solves problems with its own Numbers
+// library object, taking them from its own range of problems first, then
+// stealing problems from the ranges of the other threads)
+typedef struct {
+    NumbersBatchObject batchObject;
+    pthread_t thread;
+    NumbersObject numbersObject;
+    atomic_uint problemIdNext;
+    uint32_t problemIdLast;
+} BatchThread;
+
+// Batch object
+struct NumbersBatchStruct {
+    uint32_t threadCount;
+    BatchThread* threads;
+    pthread_mutex_t mutex;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    uint32_t generation;
+    uint32_t busyCount;
+    Bool shutdown;
+    NumbersProblem* problems;
+    NumbersError* errors;
+    NumbersSolution* solutions;
+};
 
-    // Operations
-    uint16_t operationSize;
-    Operation operations[];
+// Size of a slot of a pool (a cache line, so that threads acquiring and
+// releasing objects of neighbouring slots don't slow each other down)
+#define POOL_SLOT_SIZE 64
+
+// Slots of a pool (each slot holds a Numbers library object, which is either
+// available or acquired by a thread; aligning the first member aligns and
+// pads the whole slot)
+typedef struct {
+    _Alignas (POOL_SLOT_SIZE) atomic_uint acquired;
+    NumbersObject numbersObject;
+} PoolSlot;
+
+// Pool object
+struct NumbersPoolStruct {
+    uint32_t slotCount;
+    PoolSlot* slots;
 };
 
+// Slot of the pool last used by the current thread (each thread first tries to
+// get the object it used last, which is likely to still be in the cache of its
+// core; when it switches to another pool, each thread starts from a different
+// slot)
+static _Thread_local NumbersPoolObject poolHint;
+static _Thread_local uint32_t poolSlotIdHint;
+static _Thread_local uint32_t poolThreadId = UINT32_MAX;
+static atomic_uint poolThreadCount;
+
+// Free the arrays of a context
+static void ContextFree (Context* context) {
+    free (context->operations.results);
+#ifndef DISABLE_COMPLEXITY
+    free (context->operations.complexities);
+    free (context->operations.weights);
+#endif
+    free (context->operations.origins);
+    free (context->operationIds);
+    free (context->operationHashes);
+}
+
+// Empty the hash set of operation IDs of a context (operation IDs are reused
+// by each call to NumbersSolve, hence the need to get rid of the old ones)
+static void ContextClearHashes (Context* context) {
+    if (context->operationHashes) {
+        memset (context->operationHashes, 0xFF, sizeof (context->operationHashes[0]) * context->operationHashSize);
+    }
+    context->operationHashGroup = OPERATION_ID_NONE;
+}
+
+// Allocate the arrays of a context (to record operations, and to search for a
+// given result in a group of operations)
+static Bool ContextAllocate (Context* context, NumbersObject numbersObject, uint32_t operationSize, uint32_t operationIdSize, uint32_t operationHashSize) {
+    context->numbersObject = numbersObject;
+    context->final.pending = FALSE;
+    context->operationIdBase = 0;
+    context->operationSize = operationSize;
+    context->operationIdSize = operationIdSize;
+    context->operationHashSize = operationHashSize;
+    context->operations.results = malloc (sizeof (context->operations.results[0]) * operationSize);
+#ifndef DISABLE_COMPLEXITY
+    context->operations.complexities = malloc (sizeof (context->operations.complexities[0]) * operationSize);
+    context->operations.weights = malloc (sizeof (context->operations.weights[0]) * operationSize);
+#endif
+    context->operations.origins = malloc (sizeof (context->operations.origins[0]) * operationSize);
+    context->operationIds = malloc (sizeof (context->operationIds[0]) * operationIdSize);
+    context->operationHashes = operationHashSize ? malloc (sizeof (context->operationHashes[0]) * operationHashSize) : NULL;
+    if (!context->operations.results
+#ifndef DISABLE_COMPLEXITY
+        || !context->operations.complexities
+        || !context->operations.weights
+#endif
+        || !context->operations.origins
+        || !context->operationIds
+        || (operationHashSize && !context->operationHashes)) {
+        ContextFree (context);
+        return FALSE;
+    }
+    ContextClearHashes (context);
+    return TRUE;
+}
+
+// Grow the arrays of operations of a context, so that they have room for at
+// least operationSize operations
+static Bool ContextGrow (Context* context, uint32_t operationSize) {
+
+    // Make sure the arrays are allowed to grow
+    uint32_t operationGrowth = context->numbersObject->operationGrowth;
+    if (!operationGrowth) {
+        return FALSE;
+    }
+
+    // Compute the new size of the arrays (the IDs of all operations must
+    // remain valid)
+    uint64_t operationSizeNew = context->operationSize;
+    while (operationSizeNew < operationSize) {
+        operationSizeNew += operationGrowth;
+    }
+    if (context->operationIdBase + operationSizeNew > OPERATION_ID_NONE) {
+        operationSizeNew = OPERATION_ID_NONE - context->operationIdBase;
+        if (operationSizeNew < operationSize) {
+            return FALSE;
+        }
+    }
+
+    // Reallocate the arrays
+    void* memory = realloc (context->operations.results, sizeof (context->operations.results[0]) * operationSizeNew);
+    if (!memory) {
+        return FALSE;
+    }
+    context->operations.results = memory;
+#ifndef DISABLE_COMPLEXITY
+    memory = realloc (context->operations.complexities, sizeof (context->operations.complexities[0]) * operationSizeNew);
+    if (!memory) {
+        return FALSE;
+    }
+    context->operations.complexities = memory;
+    memory = realloc (context->operations.weights, sizeof (context->operations.weights[0]) * operationSizeNew);
+    if (!memory) {
+        return FALSE;
+    }
+    context->operations.weights = memory;
+#endif
+    memory = realloc (context->operations.origins, sizeof (context->operations.origins[0]) * operationSizeNew);
+    if (!memory) {
+        return FALSE;
+    }
+    context->operations.origins = memory;
+    context->operationSize = operationSizeNew;
+    return TRUE;
+}
+
+// Copy some operations from an array to another
+static void OperationsCopy (Operations* operationsDestination, uint32_t operationIndexDestination, Operations* operationsSource, uint32_t operationIndexSource, uint32_t operationCount) {
+    memcpy (&operationsDestination->results[operationIndexDestination], &operationsSource->results[operationIndexSource],
+        sizeof (operationsSource->results[0]) * operationCount);
+#ifndef DISABLE_COMPLEXITY
+    memcpy (&operationsDestination->complexities[operationIndexDestination], &operationsSource->complexities[operationIndexSource],
+        sizeof (operationsSource->complexities[0]) * operationCount);
+    memcpy (&operationsDestination->weights[operationIndexDestination], &operationsSource->weights[operationIndexSource],
+        sizeof (operationsSource->weights[0]) * operationCount);
+#endif
+    memcpy (&operationsDestination->origins[operationIndexDestination], &operationsSource->origins[operationIndexSource],
+        sizeof (operationsSource->origins[0]) * operationCount);
+}
+
+// Make sure the arrays which size depends on the number of tiles are large
+// enough
+static Bool TileArraysReserve (NumbersObject numbersObject, uint32_t tileCount) {
+
+    // Check whether the arrays are already large enough
+    if (numbersObject->operationGroups && tileCount <= numbersObject->tileCountMax) {
+        return TRUE;
+    }
+
+    // Reallocate the arrays
+    uint32_t operationGroupSize = 1 << tileCount;
+    void* memory = realloc (numbersObject->operationGroups, sizeof (numbersObject->operationGroups[0]) * operationGroupSize);
+    if (!memory) {
+        return FALSE;
+    }
+    numbersObject->operationGroups = memory;
+    if (numbersObject->threads.workerCount) {
+        memory = realloc (numbersObject->items, sizeof (numbersObject->items[0]) * operationGroupSize);
+        if (!memory) {
+            return FALSE;
+        }
+        numbersObject->items = memory;
+    }
+    numbersObject->tileCountMax = tileCount;
+    return TRUE;
+}
+
+// Worker thread start routine
+static void* WorkerRun (void* data);
+
+// Stop and destroy all the worker threads
+static void WorkersDestroy (NumbersObject numbersObject) {
+
+    // Stop the threads
+    pthread_mutex_lock (&numbersObject->threads.mutex);
+    numbersObject->threads.shutdown = TRUE;
+    pthread_cond_broadcast (&numbersObject->threads.start);
+    pthread_mutex_unlock (&numbersObject->threads.mutex);
+    for (uint32_t workerId = 1; workerId < numbersObject->threads.workerCount; ++workerId) {
+        pthread_join (numbersObject->threads.workers[workerId].thread, NULL);
+    }
+
+    // Free the memory of all workers
+    for (uint32_t workerId = 0; workerId < numbersObject->threads.workerCount; ++workerId) {
+        ContextFree (&numbersObject->threads.workers[workerId].context);
+    }
+    free (numbersObject->threads.workers);
+    pthread_cond_destroy (&numbersObject->threads.done);
+    pthread_cond_destroy (&numbersObject->threads.start);
+    pthread_mutex_destroy (&numbersObject->threads.mutex);
+}
+
+// Create the worker threads
+static NumbersError WorkersCreate (NumbersObject numbersObject, uint32_t workerCount) {
+
+    // Initialize the synchronization primitives
+    numbersObject->threads.workerCount = 0;
+    numbersObject->threads.generation = 0;
+    numbersObject->threads.busyCount = 0;
+    numbersObject->threads.shutdown = FALSE;
+    if (pthread_mutex_init (&numbersObject->threads.mutex, NULL)) {
+        return ThreadError;
+    }
+    if (pthread_cond_init (&numbersObject->threads.start, NULL)) {
+        pthread_mutex_destroy (&numbersObject->threads.mutex);
+        return ThreadError;
+    }
+    if (pthread_cond_init (&numbersObject->threads.done, NULL)) {
+        pthread_cond_destroy (&numbersObject->threads.start);
+        pthread_mutex_destroy (&numbersObject->threads.mutex);
+        return ThreadError;
+    }
+
+    // Allocate the workers
+    numbersObject->threads.workers = malloc (sizeof (numbersObject->threads.workers[0]) * workerCount);
+    if (!numbersObject->threads.workers) {
+        WorkersDestroy (numbersObject);
+        return MemoryAllocationError;
+    }
+
+    // Initialize each worker (each of them records operations in its own
+    // arrays, and has its own array of operation IDs)
+    uint32_t operationSize = numbersObject->context.operationSize;
+    uint32_t operationIdSize = numbersObject->context.operationIdSize;
+    uint32_t operationHashSize = numbersObject->context.operationHashSize;
+    for (uint32_t workerId = 0; workerId < workerCount; ++workerId) {
+        Worker* worker = &numbersObject->threads.workers[workerId];
+        worker->workerId = workerId;
+        if (!ContextAllocate (&worker->context, numbersObject, operationSize, operationIdSize, operationHashSize)) {
+            WorkersDestroy (numbersObject);
+            return MemoryAllocationError;
+        }
+        ++numbersObject->threads.workerCount;
+
+        // Start the thread (the first worker is the thread calling
+        // NumbersSolve)
+        if (workerId && pthread_create (&worker->thread, NULL, WorkerRun, (void*)worker)) {
+            ContextFree (&worker->context);
+            --numbersObject->threads.workerCount;
+            WorkersDestroy (numbersObject);
+            return ThreadError;
+        }
+    }
+
+    // Done
+    return Success;
+}
+
+// Compute the plan to break a group of tiles into 2 smaller groups, i.e. all
+// possible ways to break it (each way being given by the smaller group that
+// doesn't include the last tile of the group); the ways which involve the
+// largest groups come first, since these groups were recorded the most
+// recently, hence are the most likely to still be in the cache (the order only
+// decides which solution is returned among equally good ones, i.e. at the same
+// distance from the target, with the same number of tiles and complexity)
+static void SplitPlanCompute (uint32_t tileGroup, uint16_t* tileSubGroups) {
+
+    // Get the tiles of the group
+    uint32_t tileCount = __builtin_popcount (tileGroup);
+    uint32_t tiles[NUMBERS_TILE_COUNT_MAX];
+    for (uint32_t tileId = 0; tileId < tileCount; ++tileId) {
+        tiles[tileId] = tileGroup & -tileGroup;
+        tileGroup -= tiles[tileId];
+    }
+
+    // Number the smaller groups (the bits of a number referring to the tiles
+    // of the group), and count them by number of tiles of the smallest group
+    // of each way
+    uint32_t tileSubGroupCount = (1 << (tileCount - 1)) - 1;
+    uint16_t tileSubGroupsNumbered[tileSubGroupCount + 1];
+    uint32_t positions[NUMBERS_TILE_COUNT_MAX / 2 + 2];
+    for (uint32_t tileCountSmall = 0; tileCountSmall < NUMBERS_TILE_COUNT_MAX / 2 + 2; ++tileCountSmall) {
+        positions[tileCountSmall] = 0;
+    }
+    tileSubGroupsNumbered[0] = 0;
+    for (uint32_t tileSubGroupNumber = 1; tileSubGroupNumber <= tileSubGroupCount; ++tileSubGroupNumber) {
+        tileSubGroupsNumbered[tileSubGroupNumber] = tileSubGroupsNumbered[tileSubGroupNumber & (tileSubGroupNumber - 1)]
+            + tiles[__builtin_ctz (tileSubGroupNumber)];
+        uint32_t tileCountSmall = __builtin_popcount (tileSubGroupNumber);
+        if (tileCountSmall > tileCount - tileCountSmall) {
+            tileCountSmall = tileCount - tileCountSmall;
+        }
+        ++positions[tileCountSmall + 1];
+    }
+
+    // Order the ways, from the most unbalanced to the most balanced
+    for (uint32_t tileCountSmall = 1; tileCountSmall < NUMBERS_TILE_COUNT_MAX / 2 + 2; ++tileCountSmall) {
+        positions[tileCountSmall] += positions[tileCountSmall - 1];
+    }
+    for (uint32_t tileSubGroupNumber = 1; tileSubGroupNumber <= tileSubGroupCount; ++tileSubGroupNumber) {
+        uint32_t tileCountSmall = __builtin_popcount (tileSubGroupNumber);
+        if (tileCountSmall > tileCount - tileCountSmall) {
+            tileCountSmall = tileCount - tileCountSmall;
+        }
+        tileSubGroups[positions[tileCountSmall]++] = tileSubGroupsNumbered[tileSubGroupNumber];
+    }
+}
+
+// Compute the plans to break all groups of up to SPLIT_PLAN_TILE_COUNT_MAX
+// tiles
+static void SplitPlansCompute (void) {
+    uint32_t offset = 0;
+    for (uint32_t tileGroup = 0; tileGroup < (1 << SPLIT_PLAN_TILE_COUNT_MAX); ++tileGroup) {
+        splitPlans.offsets[tileGroup] = offset;
+        if (__builtin_popcount (tileGroup) > 1) {
+            SplitPlanCompute (tileGroup, &splitPlans.tileSubGroups[offset]);
+            offset += (1 << (__builtin_popcount (tileGroup) - 1)) - 1;
+        }
+    }
+}
+
 // Initialize the library
-extern NumbersError NumbersInitialize (uint16_t operationSize, uint16_t operationIdSize, NumbersObject* numbersObject_) {
+extern NumbersError NumbersInitializeWithOptions (NumbersOptions* options, NumbersObject* numbersObject_) {
 
-    // Check the pointer
+    // Check the pointers
     if (!numbersObject_) {
         return NullPointerError;
     }
     *numbersObject_ = NULL;
+    if (!options) {
+        return NullPointerError;
+    }
 
-    // Check the size parameters
-    if (!operationSize || !operationIdSize) {
+    // Check the size parameters (operation IDs shall all be different from
+    // OPERATION_ID_NONE)
+    if (!options->operationSize || !options->operationIdSize) {
         return ZeroSizeError;
     }
+    if (options->operationSize > OPERATION_ID_NONE) {
+        return TooLargeSizeError;
+    }
+
+#ifndef NUMBERS_VARIANT
+
+    // Let the variant of the library that suits the options and the processor
+    // best initialize the object (this one being the fallback, unless
+    // complexity isn't needed)
+    if (options->checkOverflow) {
+        return options->disableComplexity
+            ? NumbersInitializeWithOptionsCheckOverflowWithoutComplexity (options, numbersObject_)
+            : NumbersInitializeWithOptionsCheckOverflow (options, numbersObject_);
+    }
+    if (options->collectStatistics) {
+        return options->disableComplexity
+            ? NumbersInitializeWithOptionsStatisticsWithoutComplexity (options, numbersObject_)
+            : NumbersInitializeWithOptionsStatistics (options, numbersObject_);
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports ("avx2")) {
+        return options->disableComplexity
+            ? NumbersInitializeWithOptionsAvx2WithoutComplexity (options, numbersObject_)
+            : NumbersInitializeWithOptionsAvx2 (options, numbersObject_);
+    }
+    if (__builtin_cpu_supports ("sse4.2")) {
+        return options->disableComplexity
+            ? NumbersInitializeWithOptionsSse42WithoutComplexity (options, numbersObject_)
+            : NumbersInitializeWithOptionsSse42 (options, numbersObject_);
+    }
+#endif
+    if (options->disableComplexity) {
+        return NumbersInitializeWithOptionsWithoutComplexity (options, numbersObject_);
+    }
+#endif
+
+    // Compute the plans to break small groups of tiles (once for all objects)
+    pthread_once (&splitPlans.once, SplitPlansCompute);
 
-    // Allocate an object (including an array to record all operations, and an
-    // array to allow searching for a given result in a group of operations)
-    NumbersObject numbersObject = malloc (sizeof (struct NumbersStruct)
-        + sizeof (numbersObject->operations[0]) * operationSize
-        + sizeof (numbersObject->operationIds[0]) * operationIdSize);
+    // Allocate an object
+    NumbersObject numbersObject = malloc (sizeof (struct NumbersStruct));
     if (!numbersObject) {
         return MemoryAllocationError;
     }
+    numbersObject->variant = &variant;
+#ifndef DISABLE_COMPLEXITY
+    numbersObject->complexityDisabled = FALSE;
+#else
+    numbersObject->complexityDisabled = TRUE;
+#endif
+#ifdef CHECK_OVERFLOW
+    numbersObject->overflowChecked = TRUE;
+#else
+    numbersObject->overflowChecked = FALSE;
+#endif
+    numbersObject->operationGrowth = options->operationGrowth;
+    numbersObject->limits.enabled = FALSE;
+    memset (&numbersObject->statistics, 0, sizeof (numbersObject->statistics));
+    numbersObject->tileCountMax = 0;
+    numbersObject->operationGroups = NULL;
+    numbersObject->items = NULL;
+    numbersObject->sorted.size = 0;
+    numbersObject->sorted.operations = NULL;
+    numbersObject->sorted.buffer = NULL;
+
+    // Allocate the arrays to record all operations, and an array (as well as a
+    // hash set, unless disabled) to allow searching for a given result in a
+    // group of operations
+    uint32_t operationHashSize = options->disableResultHash ? 0 : OPERATION_HASH_SIZE_MIN;
+    if (!ContextAllocate (&numbersObject->context, numbersObject, options->operationSize, options->operationIdSize, operationHashSize)) {
+        free (numbersObject);
+        return MemoryAllocationError;
+    }
 
-    // Initialize the object
-    numbersObject->operationSize = operationSize;
-    numbersObject->operationIdSize = operationIdSize;
-    numbersObject->operationIds = (uint16_t*)&numbersObject->operations[operationSize];
+    // Create the worker threads (if any)
+    numbersObject->threads.workerCount = 0;
+    if (options->threadCount > 1) {
+        NumbersError error = WorkersCreate (numbersObject, options->threadCount);
+        if (error != Success) {
+            ContextFree (&numbersObject->context);
+            free (numbersObject);
+            return error;
+        }
+    }
 
     // Return the object
     *numbersObject_ = numbersObject;
@@ -114,6 +974,12 @@ extern NumbersError NumbersInitialize (uint16_t operationSize, uint16_t operatio
     return Success;
 }
 
+// Initialize the library
+extern NumbersError NumbersInitialize (uint16_t operationSize, uint16_t operationIdSize, NumbersObject* numbersObject) {
+    NumbersOptions options = {.operationSize = operationSize, .operationIdSize = operationIdSize, .threadCount = 1};
+    return NumbersInitializeWithOptions (&options, numbersObject);
+}
+
 // Shut down the library
 extern NumbersError NumbersShutdown (NumbersObject numbersObject) {
 
@@ -122,7 +988,23 @@ extern NumbersError NumbersShutdown (NumbersObject numbersObject) {
         return NullPointerError;
     }
 
+    // Let the variant of the library that initialized the object deal with it
+    // (if it isn't this one)
+    if (numbersObject->variant != &variant) {
+        return numbersObject->variant->shutdown (numbersObject);
+    }
+
+    // Destroy the worker threads (if any)
+    if (numbersObject->threads.workerCount) {
+        WorkersDestroy (numbersObject);
+    }
+
     // Destroy the object
+    free (numbersObject->sorted.buffer);
+    free (numbersObject->sorted.operations);
+    free (numbersObject->items);
+    free (numbersObject->operationGroups);
+    ContextFree (&numbersObject->context);
     free (numbersObject);
 
     // Done
@@ -132,16 +1014,83 @@ extern NumbersError NumbersShutdown (NumbersObject numbersObject) {
 // Search for a given result in the current operation group
 // Note: better not perform a linear search if the result is outside the array,
 // this would be slower than to record and process the duplicate result!
-inline static uint16_t SearchOperation (NumbersObject numbersObject, uint32_t result) {
-    if (result < numbersObject->operationIdSize) {
-        uint16_t operationId = numbersObject->operationIds[result];
-        if (operationId >= numbersObject->current.operationIdFirst
-            && operationId < numbersObject->current.operationIdLast
-            && numbersObject->operations[operationId].result == result) {
+inline static OperationId SearchOperation (Context* context, uint32_t result) {
+    if (result < context->operationIdSize) {
+        OperationId operationId = context->operationIds[result];
+        if (operationId >= context->current.operationIdFirst
+            && operationId < context->current.operationIdLast
+            && context->operations.results[operationId - context->operationIdBase] == result) {
             return operationId;
         }
+    } else if (context->operationHashes) {
+
+        // Probe the hash set until an empty slot is found
+        uint32_t slotMask = context->operationHashSize - 1;
+        uint32_t slot = OPERATION_HASH (result) & slotMask;
+        while (1) {
+            OperationId operationId = context->operationHashes[slot];
+            if (operationId < context->current.operationIdFirst
+                || operationId >= context->current.operationIdLast) {
+                break;
+            }
+            if (context->operations.results[operationId - context->operationIdBase] == result) {
+                return operationId;
+            }
+            slot = (slot + 1) & slotMask;
+        }
+    }
+    return context->current.operationIdLast;
+}
+
+// Insert the ID of an operation in the hash set (replacing the ID of any
+// operation of the current group with the same result)
+inline static void HashOperationInsert (Context* context, uint32_t result, OperationId operationId) {
+    uint32_t slotMask = context->operationHashSize - 1;
+    uint32_t slot = OPERATION_HASH (result) & slotMask;
+    while (1) {
+        OperationId operationIdSlot = context->operationHashes[slot];
+        if (operationIdSlot < context->current.operationIdFirst
+            || operationIdSlot >= context->current.operationIdLast
+            || context->operations.results[operationIdSlot - context->operationIdBase] == result) {
+            context->operationHashes[slot] = operationId;
+            return;
+        }
+        slot = (slot + 1) & slotMask;
     }
-    return numbersObject->current.operationIdLast;
+}
+
+// Record the ID of a new operation in the hash set, making it larger if needed
+static void HashOperation (Context* context, uint32_t result, OperationId operationId) {
+
+    // Count the operations of the current group in the hash set
+    if (context->operationHashGroup != context->current.operationIdFirst) {
+        context->operationHashGroup = context->current.operationIdFirst;
+        context->operationHashCount = 0;
+    }
+    if ((context->operationHashCount + 1) << 1 > context->operationHashSize) {
+
+        // Double the size of the hash set (or give up deduplicating the
+        // results of this group if there is no memory left)
+        uint32_t operationHashSize = context->operationHashSize << 1;
+        OperationId* operationHashes = realloc (context->operationHashes, sizeof (operationHashes[0]) * operationHashSize);
+        if (!operationHashes) {
+            return;
+        }
+        context->operationHashes = operationHashes;
+        context->operationHashSize = operationHashSize;
+
+        // Insert the operations of the current group again
+        memset (operationHashes, 0xFF, sizeof (operationHashes[0]) * operationHashSize);
+        for (OperationId operationIdGroup = context->current.operationIdFirst;
+            operationIdGroup < context->current.operationIdLast; ++operationIdGroup) {
+            uint32_t resultGroup = context->operations.results[operationIdGroup - context->operationIdBase];
+            if (resultGroup >= context->operationIdSize) {
+                HashOperationInsert (context, resultGroup, operationIdGroup);
+            }
+        }
+    }
+    ++context->operationHashCount;
+    HashOperationInsert (context, result, operationId);
 }
 
 #ifndef DISABLE_COMPLEXITY
@@ -171,12 +1120,83 @@ static uint8_t ComputeResultWeight (uint32_t result) {
 }
 #endif
 
+// Check whether a solution is better than another one found in an earlier
+// group of the same layer
+inline static Bool IsBetterSolution (Solution* solution, Solution* solutionReference) {
+    if (solution->targetDiff != solutionReference->targetDiff) {
+        return solution->targetDiff < solutionReference->targetDiff ? TRUE : FALSE;
+    }
+    return solution->tileCount == solutionReference->tileCount
+#ifndef DISABLE_COMPLEXITY
+        && solution->complexity < solutionReference->complexity
+#endif
+        ? TRUE : FALSE;
+}
+
+// Check whether results that can't beat the best solution can be discarded
+// (in the final layer, or once the target has been reached, as the search then
+// stops at the end of the layer)
+inline static Bool IsPruningLayer (NumbersObject numbersObject, Context* context) {
+    return numbersObject->current.tileCount == numbersObject->final.tileCountPruning
+        || (context->solution.targetDiff == 0 && numbersObject->final.tileCountPruning) ? TRUE : FALSE;
+}
+
+// Check whether the search is over (the target has been reached, and no other
+// solution could have a lower complexity)
+inline static Bool IsSearchOver (NumbersObject numbersObject, Context* context) {
+    return context->solution.targetDiff == 0
+#ifndef DISABLE_COMPLEXITY
+        && context->solution.complexity == 0
+#endif
+        && numbersObject->final.tileCountPruning ? TRUE : FALSE;
+}
+
+// Get the time of the monotonic clock (in nanoseconds)
+static uint64_t GetTime (void) {
+    struct timespec time;
+    clock_gettime (CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+// Check whether the search exceeds its limits, taking into account some more
+// pairs of operations to combine (once a limit is exceeded, all threads stop)
+static Bool IsLimitExceeded (NumbersObject numbersObject, uint64_t operationCount) {
+    if (atomic_load (&numbersObject->limits.exceeded)) {
+        return TRUE;
+    }
+    if ((numbersObject->limits.cancel && __atomic_load_n (numbersObject->limits.cancel, __ATOMIC_RELAXED))
+        || (numbersObject->limits.operationBudget
+            && atomic_fetch_add (&numbersObject->limits.operationCount, operationCount) + operationCount > numbersObject->limits.operationBudget)
+        || (numbersObject->limits.deadline && GetTime () > numbersObject->limits.deadline)) {
+        atomic_store (&numbersObject->limits.exceeded, TRUE);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+#ifndef DISABLE_COMPLEXITY
+// Get the lowest complexity of some operations
+static uint16_t GetComplexityMin (Context* context, OperationId operationIdFirst, OperationId operationIdLast, uint16_t complexityMin) {
+    uint16_t* complexities = context->operations.complexities;
+    for (OperationId operationId = operationIdFirst; operationId < operationIdLast; ++operationId) {
+        if (complexityMin > complexities[operationId]) {
+            complexityMin = complexities[operationId];
+        }
+    }
+    return complexityMin;
+}
+#endif
+
 // Record an operation
-static void RecordOperation (NumbersObject numbersObject, Operator op, uint32_t result, uint16_t complexity) {
+static void RecordOperation (Context* context, Operator op, uint32_t result, uint16_t complexity) {
+
+    // Get the object
+    NumbersObject numbersObject = context->numbersObject;
 
 #ifndef DISABLE_COMPLEXITY
     // Check the complexity
     if (complexity > numbersObject->current.complexityMax) {
+        StatisticsAdd (context, complexityPruned, 1);
         return;
     }
 #endif
@@ -189,342 +1209,2630 @@ static void RecordOperation (NumbersObject numbersObject, Operator op, uint32_t
         targetDiff = numbersObject->final.target - result;
     }
 
-    Bool bestResult = TRUE;
-    uint16_t operationId;
-    if (targetDiff < numbersObject->solution.targetDiff
-        || numbersObject->solution.operationId >= numbersObject->operationSize) {
-
-        // No doubt, this is the best result so far
-        operationId = numbersObject->current.operationIdLast;
-    } else if (numbersObject->current.tileCount == numbersObject->final.tileCount) {
+    // In the final layer, only keep track of the best operation (none of the
+    // operations of this layer will ever be combined again)
+    if (IsPruningLayer (numbersObject, context)) {
 
         // Check whether this result is the best
-        if (targetDiff > numbersObject->solution.targetDiff
+        if ((context->solution.operationId != OPERATION_ID_NONE || context->final.pending)
+            && (targetDiff > context->solution.targetDiff
+                || (targetDiff == context->solution.targetDiff
 #ifndef DISABLE_COMPLEXITY
-            || complexity >= numbersObject->operations[numbersObject->solution.operationId].complexity
+                    && (complexity >= context->solution.complexity
+                        || numbersObject->current.tileCount > context->solution.tileCount)
+#else
+                    && numbersObject->current.tileCount > context->solution.tileCount
 #endif
-            || numbersObject->current.tileCount > numbersObject->solution.tileCount) {
-
-            // No need to record an operation that will never be used
+                    ))) {
             return;
         }
 
-        // Check whether this result has already been recorded in this group
-        operationId = SearchOperation (numbersObject, result);
-    } else {
-
-        // Check whether this result has already been recorded in this group
-        operationId = SearchOperation (numbersObject, result);
-        if (operationId == numbersObject->current.operationIdLast) {
+        // Take note of the solution referring to an operation actually
+        // recorded
+        if (!context->final.pending) {
+            context->final.pending = TRUE;
+            context->final.solutionRecorded = context->solution;
+        }
 
-            // Check whether this result is the best
-            bestResult = targetDiff == numbersObject->solution.targetDiff
+        // Take note of the best operation so far
+        context->final.result = result;
+        context->final.origin.operationIdLeft = context->current.operationIdLeft;
+        context->final.origin.operationIdRight = context->current.operationIdRight;
+        context->final.origin.op = op;
+        context->solution.targetDiff = targetDiff;
+        context->solution.tileCount = numbersObject->current.tileCount;
 #ifndef DISABLE_COMPLEXITY
-                && complexity < numbersObject->operations[numbersObject->solution.operationId].complexity
-#endif
-                && numbersObject->current.tileCount == numbersObject->solution.tileCount ?
-                TRUE : FALSE;
-#ifndef DISABLE_COMPLEXITY
-        } else if (complexity >= numbersObject->operations[operationId].complexity) {
-#else
-        } else {
+        context->solution.complexity = complexity;
 #endif
+        return;
+    }
+
+    Bool bestResult = TRUE;
+    OperationId operationId;
+    if (targetDiff < context->solution.targetDiff
+        || context->solution.operationId == OPERATION_ID_NONE) {
+
+        // No doubt, this is the best result so far
+        operationId = context->current.operationIdLast;
+    } else {
+
+        // Check whether this result has already been recorded in this group
+        operationId = SearchOperation (context, result);
+        if (operationId == context->current.operationIdLast) {
+            StatisticsAdd (context, duplicateMisses, 1);
+        } else {
+            StatisticsAdd (context, duplicateHits, 1);
+
+            // Make sure no operation with the same result and a lower (or
+            // equal) complexity is already recorded...
+#ifndef DISABLE_COMPLEXITY
+            if (complexity >= context->operations.complexities[operationId - context->operationIdBase]) {
+                return;
+            }
+#else
+            return;
+#endif
+        }
+
+        // Check whether this result is the best (whether it is recorded by a
+        // new operation, or by an operation recorded earlier that gets simpler)
+        bestResult = targetDiff == context->solution.targetDiff
+#ifndef DISABLE_COMPLEXITY
+            && complexity < context->solution.complexity
+#endif
+            && numbersObject->current.tileCount == context->solution.tileCount ?
+            TRUE : FALSE;
+    }
+
+    // Record or update the operation
+    uint32_t operationIndex = operationId - context->operationIdBase;
+    if (operationId == context->current.operationIdLast) {
+
+        // Make sure the operation can be recorded
+        if (operationId == OPERATION_ID_NONE
+            || (operationIndex >= context->operationSize && !ContextGrow (context, operationIndex + 1))) {
+
+            // The arrays are full, let's return the best solution found so
+            // far...
+            context->solution.aborted = TRUE;
+            return;
+        }
+
+        // If possible, record the ID of this operation, to allow searching for
+        // its result
+        if (result < context->operationIdSize) {
+            context->operationIds[result] = operationId;
+        } else {
+            StatisticsAdd (context, outsideResults, 1);
+            if (context->operationHashes) {
+                HashOperation (context, result, operationId);
+            }
+        }
+
+        // Record the operation
+        context->operations.results[operationIndex] = result;
+        ++context->current.operationIdLast;
+
+#ifndef DISABLE_COMPLEXITY
+        // Take note of the "weight" of this result, to allow computing the
+        // complexity of operations
+        context->operations.weights[operationIndex] = ComputeResultWeight (result);
+#endif
+    }
+    OperationOrigin* origin = &context->operations.origins[operationIndex];
+    origin->operationIdLeft = context->current.operationIdLeft;
+    origin->operationIdRight = context->current.operationIdRight;
+    origin->op = op;
+#ifndef DISABLE_COMPLEXITY
+    context->operations.complexities[operationIndex] = complexity;
+#endif
+
+    // Take note of the best solution so far
+    if (bestResult) {
+        context->solution.operationId = operationId;
+        context->solution.targetDiff = targetDiff;
+        context->solution.tileCount = numbersObject->current.tileCount;
+#ifndef DISABLE_COMPLEXITY
+        context->solution.complexity = complexity;
+#endif
+    }
+}
+
+// Record the best operation found in the final layer (if any)
+static void RecordFinalOperation (Context* context) {
+
+    // Make sure there is an operation to record
+    if (!context->final.pending) {
+        return;
+    }
+    context->final.pending = FALSE;
+
+    // Make sure the operation can be recorded
+    OperationId operationId = context->current.operationIdLast;
+    uint32_t operationIndex = operationId - context->operationIdBase;
+    if (operationId == OPERATION_ID_NONE
+        || (operationIndex >= context->operationSize && !ContextGrow (context, operationIndex + 1))) {
+
+        // The arrays are full, let's return the best solution recorded so
+        // far...
+        context->solution = context->final.solutionRecorded;
+        context->solution.aborted = TRUE;
+        return;
+    }
+
+    // Record the operation (without recording its ID, as it will never be
+    // searched for)
+    context->operations.results[operationIndex] = context->final.result;
+    context->operations.origins[operationIndex] = context->final.origin;
+#ifndef DISABLE_COMPLEXITY
+    context->operations.complexities[operationIndex] = context->solution.complexity;
+    context->operations.weights[operationIndex] = ComputeResultWeight (context->final.result);
+#endif
+    ++context->current.operationIdLast;
+    context->solution.operationId = operationId;
+}
+
+// Order 2 results, taking note of the operations which give the left and the
+// right operands
+inline static void OrderResults (Context* context, OperationId operationIdA, OperationId operationIdB, uint32_t resultA, uint32_t resultB, uint32_t* resultMax, uint32_t* resultMin) {
+    if (resultA >= resultB) {
+        *resultMax = resultA;
+        *resultMin = resultB;
+        context->current.operationIdLeft = operationIdA;
+        context->current.operationIdRight = operationIdB;
+    } else {
+        *resultMax = resultB;
+        *resultMin = resultA;
+        context->current.operationIdLeft = operationIdB;
+        context->current.operationIdRight = operationIdA;
+    }
+}
+
+// Record the operation performed by an operator on 2 ordered results, if it is
+// valid (this function is always inlined with a constant operator, so that
+// only the code of this operator remains)
+__attribute__((always_inline)) inline static void CombineOrderedResults (Context* context, Operator op, uint32_t resultMax, uint32_t resultMin, uint16_t complexityAB, uint8_t weightA, uint8_t weightB) {
+#ifndef DISABLE_COMPLEXITY
+    uint16_t complexity;
+#else
+    uint16_t complexity = 0;
+#endif
+    switch (op) {
+        case ADD:
+
+            // Addition
+#ifndef DISABLE_COMPLEXITY
+            complexity = complexityAB + (weightA < weightB ? weightA : weightB);
+#endif
+            if (!IsAdditionOverflowing (resultMax, resultMin)) {
+                RecordOperation (context, ADD, resultMax + resultMin, complexity);
+            }
+            break;
+        case SUB:
+
+            // Subtraction
+            if (resultMax != resultMin && resultMax - resultMin != resultMin) {
+#ifndef DISABLE_COMPLEXITY
+                complexity = complexityAB + ((weightA + weightB) >> 1);
+#endif
+                RecordOperation (context, SUB, resultMax - resultMin, complexity);
+            }
+            break;
+        case MUL:
+
+            // Multiplication (the smallest number shall be greater than 1)
+            if (resultMin > 1 && !IsMultiplicationOverflowing (resultMax, resultMin)) {
+#ifndef DISABLE_COMPLEXITY
+                complexity = weightA * weightB;
+                complexity = complexityAB + complexity * complexity;
+#endif
+                RecordOperation (context, MUL, resultMax * resultMin, complexity);
+            }
+            break;
+        default:
+
+            // Division (the smallest number shall be greater than 1)
+            if (resultMin <= 1) {
+                break;
+            }
+            if (resultMax == resultMin) {
+#ifndef DISABLE_COMPLEXITY
+                complexity = complexityAB + 1;
+#endif
+                RecordOperation (context, DIV, 1, complexity);
+            } else {
+                uint32_t result = resultMax / resultMin;
+                if (result != resultMin && result * resultMin == resultMax) {
+
+                    // Note: when such a division is actually possible
+                    // (which is not so frequent), it is probably not much
+                    // harder to find than to perform the multiplication,
+                    // hence the use of the same "complexity" value here
+#ifndef DISABLE_COMPLEXITY
+                    complexity = weightA * weightB;
+                    complexity = complexityAB + complexity * complexity;
+#endif
+                    RecordOperation (context, DIV, result, complexity);
+                }
+            }
+            break;
+    }
+}
+
+// Combine 2 results, recording all the operations that can be performed with
+// them
+inline static void CombineOperations (Context* context, OperationId operationIdA, OperationId operationIdB, uint32_t resultA, uint32_t resultB, uint16_t complexityAB, uint8_t weightA, uint8_t weightB) {
+    uint32_t resultMax;
+    uint32_t resultMin;
+    OrderResults (context, operationIdA, operationIdB, resultA, resultB, &resultMax, &resultMin);
+    CombineOrderedResults (context, ADD, resultMax, resultMin, complexityAB, weightA, weightB);
+    CombineOrderedResults (context, SUB, resultMax, resultMin, complexityAB, weightA, weightB);
+    CombineOrderedResults (context, MUL, resultMax, resultMin, complexityAB, weightA, weightB);
+    CombineOrderedResults (context, DIV, resultMax, resultMin, complexityAB, weightA, weightB);
+}
+
+#ifdef VECTOR_WIDTH
+// Get the mask of the results which are not further from the target than a
+// given difference
+inline static uint32_t VectorMaskCloseResults (Vector results, Vector target, Vector targetDiffMax) {
+    Vector targetDiff = VectorSub (VectorMax (results, target), VectorMin (results, target));
+    return VectorMask (VectorEqual (VectorMax (targetDiff, targetDiffMax), targetDiffMax));
+}
+
+// Combine a result with a block of VECTOR_WIDTH results, computing all 4
+// operations at once for the whole block, then recording the valid ones
+static void CombineOperationBlock (Context* context, OperationId operationIdA, OperationId operationIdB, uint32_t resultA, uint32_t* resultsB, uint16_t complexityA, uint16_t* complexitiesB, uint8_t weightA, uint8_t* weightsB) {
+
+    // Order the results
+    Vector vectorA = VectorSet (resultA);
+    Vector vectorB = VectorLoad (resultsB);
+    Vector resultMax = VectorMax (vectorA, vectorB);
+    Vector resultMin = VectorMin (vectorA, vectorB);
+    uint32_t maskLeftA = VectorMask (VectorEqual (resultMax, vectorA));
+
+    // Compute the results of all operations
+    Vector one = VectorSet (1);
+    Vector resultsAdd = VectorAdd (resultMax, resultMin);
+    Vector resultsSub = VectorSub (resultMax, resultMin);
+    Vector resultsMul = VectorMul (resultMax, resultMin);
+    Vector resultsDiv = VectorDivide (resultMax, resultMin);
+
+    // Check which operations are valid: subtractions shall not give 0 nor the
+    // smallest number, multiplications and divisions require the smallest
+    // number to be greater than 1, and divisions shall be exact and not give
+    // the smallest number
+    Vector resultMinBelow2 = VectorNot (VectorEqual (resultMin, VectorMax (resultMin, VectorSet (2))));
+    Vector validSub = VectorNot (VectorOr (VectorEqual (resultMax, resultMin), VectorEqual (resultsSub, resultMin)));
+    Vector validMul = VectorNot (resultMinBelow2);
+    Vector validDiv = VectorAndNot (VectorOr (resultMinBelow2, VectorEqual (resultsDiv, resultMin)),
+        VectorEqual (VectorMul (resultsDiv, resultMin), resultMax));
+    resultsDiv = VectorBlend (resultsDiv, one, VectorEqual (resultMax, resultMin));
+
+#ifndef DISABLE_COMPLEXITY
+    // Compute the complexity of all operations (as 16-bit values), and make
+    // sure it doesn't exceed the maximum
+    Vector complexityMax = VectorSet (context->numbersObject->current.complexityMax);
+    Vector complexityMask = VectorSet (UINT16_MAX);
+    Vector vectorWeightA = VectorSet (weightA);
+    Vector vectorWeightB = VectorLoadWeights (weightsB);
+    Vector complexityAB = VectorAnd (VectorAdd (VectorSet (complexityA), VectorLoadComplexities (complexitiesB)), complexityMask);
+    Vector complexitiesAdd = VectorAnd (VectorAdd (complexityAB, VectorMin (vectorWeightA, vectorWeightB)), complexityMask);
+    Vector complexitiesSub = VectorAnd (VectorAdd (complexityAB, VectorShiftRight (VectorAdd (vectorWeightA, vectorWeightB), 1)), complexityMask);
+    Vector weightAB = VectorMul (vectorWeightA, vectorWeightB);
+    Vector complexitiesMul = VectorAnd (VectorAdd (complexityAB, VectorMul (weightAB, weightAB)), complexityMask);
+    Vector complexitiesDiv = VectorBlend (complexitiesMul, VectorAnd (VectorAdd (complexityAB, one), complexityMask), VectorEqual (resultMax, resultMin));
+    Vector valid = VectorNot (VectorGreater (complexityAB, complexityMax));
+#ifdef ENABLE_STATISTICS
+    StatisticsAdd (context, complexityPruned, __builtin_popcount (VectorMask (VectorNot (valid)))
+        + __builtin_popcount (VectorMask (VectorAnd (valid, VectorGreater (complexitiesAdd, complexityMax))))
+        + __builtin_popcount (VectorMask (VectorAnd (VectorAnd (validSub, valid), VectorGreater (complexitiesSub, complexityMax))))
+        + __builtin_popcount (VectorMask (VectorAnd (VectorAnd (validMul, valid), VectorGreater (complexitiesMul, complexityMax))))
+        + __builtin_popcount (VectorMask (VectorAnd (VectorAnd (validDiv, valid), VectorGreater (complexitiesDiv, complexityMax)))));
+#endif
+    Vector validAdd = VectorAndNot (VectorGreater (complexitiesAdd, complexityMax), valid);
+    validSub = VectorAndNot (VectorGreater (complexitiesSub, complexityMax), VectorAnd (validSub, valid));
+    validMul = VectorAndNot (VectorGreater (complexitiesMul, complexityMax), VectorAnd (validMul, valid));
+    validDiv = VectorAndNot (VectorGreater (complexitiesDiv, complexityMax), VectorAnd (validDiv, valid));
+    uint32_t maskAdd = VectorMask (validAdd);
+#else
+    uint32_t maskAdd = (1 << VECTOR_WIDTH) - 1;
+#endif
+    uint32_t maskSub = VectorMask (validSub);
+    uint32_t maskMul = VectorMask (validMul);
+    uint32_t maskDiv = VectorMask (validDiv);
+
+    // In the final layer, results further from the target than the best
+    // solution so far will never be recorded: discard them right away
+    NumbersObject numbersObject = context->numbersObject;
+    if (IsPruningLayer (numbersObject, context)) {
+        Vector target = VectorSet (numbersObject->final.target);
+        Vector targetDiffMax = VectorSet (context->solution.targetDiff);
+        maskAdd &= VectorMaskCloseResults (resultsAdd, target, targetDiffMax);
+        maskSub &= VectorMaskCloseResults (resultsSub, target, targetDiffMax);
+        maskMul &= VectorMaskCloseResults (resultsMul, target, targetDiffMax);
+        maskDiv &= VectorMaskCloseResults (resultsDiv, target, targetDiffMax);
+    }
+    uint32_t mask = maskAdd | maskSub | maskMul | maskDiv;
+    if (!mask) {
+        return;
+    }
+
+    // Store the results
+    uint32_t results[4][VECTOR_WIDTH];
+    VectorStore (results[ADD], resultsAdd);
+    VectorStore (results[SUB], resultsSub);
+    VectorStore (results[MUL], resultsMul);
+    VectorStore (results[DIV], resultsDiv);
+#ifndef DISABLE_COMPLEXITY
+    uint32_t complexities[4][VECTOR_WIDTH];
+    VectorStore (complexities[ADD], complexitiesAdd);
+    VectorStore (complexities[SUB], complexitiesSub);
+    VectorStore (complexities[MUL], complexitiesMul);
+    VectorStore (complexities[DIV], complexitiesDiv);
+#endif
+
+    // Record the valid operations, in the same order as CombineOperations
+    do {
+        uint32_t lane = __builtin_ctz (mask);
+        uint32_t laneBit = 1 << lane;
+        mask &= mask - 1;
+        if (maskLeftA & laneBit) {
+            context->current.operationIdLeft = operationIdA;
+            context->current.operationIdRight = operationIdB + lane;
+        } else {
+            context->current.operationIdLeft = operationIdB + lane;
+            context->current.operationIdRight = operationIdA;
+        }
+#ifndef DISABLE_COMPLEXITY
+        if (maskAdd & laneBit) {
+            RecordOperation (context, ADD, results[ADD][lane], complexities[ADD][lane]);
+        }
+        if (maskSub & laneBit) {
+            RecordOperation (context, SUB, results[SUB][lane], complexities[SUB][lane]);
+        }
+        if (maskMul & laneBit) {
+            RecordOperation (context, MUL, results[MUL][lane], complexities[MUL][lane]);
+        }
+        if (maskDiv & laneBit) {
+            RecordOperation (context, DIV, results[DIV][lane], complexities[DIV][lane]);
+        }
+#else
+        if (maskAdd & laneBit) {
+            RecordOperation (context, ADD, results[ADD][lane], 0);
+        }
+        if (maskSub & laneBit) {
+            RecordOperation (context, SUB, results[SUB][lane], 0);
+        }
+        if (maskMul & laneBit) {
+            RecordOperation (context, MUL, results[MUL][lane], 0);
+        }
+        if (maskDiv & laneBit) {
+            RecordOperation (context, DIV, results[DIV][lane], 0);
+        }
+#endif
+    } while (mask);
+}
+#endif
+
+// Sort operations according to their results (radix sort, skipping the
+// passes in which all results have the same digit, or insertion sort for
+// small arrays)
+static void SortOperations (uint64_t* operations, uint64_t* buffer, uint32_t operationCount) {
+
+    // Insertion sort
+    if (operationCount <= 32) {
+        for (uint32_t operationIndex = 1; operationIndex < operationCount; ++operationIndex) {
+            uint64_t operation = operations[operationIndex];
+            uint32_t operationIndexSorted = operationIndex;
+            while (operationIndexSorted && operations[operationIndexSorted - 1] >> 32 > operation >> 32) {
+                operations[operationIndexSorted] = operations[operationIndexSorted - 1];
+                --operationIndexSorted;
+            }
+            operations[operationIndexSorted] = operation;
+        }
+        return;
+    }
+
+    // Radix sort (8 bits per pass)
+    uint64_t* operationsSource = operations;
+    uint64_t* operationsDestination = buffer;
+    for (uint32_t shift = 32; shift < 64; shift += 8) {
+        uint32_t counts[256] = {0};
+        for (uint32_t operationIndex = 0; operationIndex < operationCount; ++operationIndex) {
+            ++counts[(operationsSource[operationIndex] >> shift) & 255];
+        }
+        if (counts[(operationsSource[0] >> shift) & 255] == operationCount) {
+            continue;
+        }
+        uint32_t position = 0;
+        for (uint32_t digit = 0; digit < 256; ++digit) {
+            uint32_t count = counts[digit];
+            counts[digit] = position;
+            position += count;
+        }
+        for (uint32_t operationIndex = 0; operationIndex < operationCount; ++operationIndex) {
+            uint64_t operation = operationsSource[operationIndex];
+            operationsDestination[counts[(operation >> shift) & 255]++] = operation;
+        }
+        uint64_t* operationsSwap = operationsSource;
+        operationsSource = operationsDestination;
+        operationsDestination = operationsSwap;
+    }
+    if (operationsSource != operations) {
+        memcpy (operations, operationsSource, sizeof (operations[0]) * operationCount);
+    }
+}
+
+// Check whether a group of tiles is canonical within a larger one, i.e. whether
+// for each of its values, it uses the tiles of the larger group having this
+// value with the lowest IDs
+inline static Bool IsCanonicalTileGroup (NumbersObject numbersObject, uint32_t tileGroup, uint32_t tileGroupParent) {
+    uint32_t tiles = tileGroup & numbersObject->duplicates.tileGroup;
+    while (tiles) {
+        uint32_t tile = tiles & -tiles;
+        if (numbersObject->duplicates.tileGroups[__builtin_ctz (tile)] & (tile - 1) & tileGroupParent & ~tileGroup) {
+            return FALSE;
+        }
+        tiles -= tile;
+    }
+    return TRUE;
+}
+
+// Get the canonical group of tiles equivalent to a group of tiles within a
+// larger one (same number of tiles of each value, using the tiles of the
+// larger group with the lowest IDs)
+static uint32_t GetCanonicalTileGroup (NumbersObject numbersObject, uint32_t tileGroup, uint32_t tileGroupParent) {
+    uint32_t tiles = tileGroup & numbersObject->duplicates.tileGroup;
+    while (tiles) {
+        uint32_t tile = tiles & -tiles;
+        uint32_t tilesFree = numbersObject->duplicates.tileGroups[__builtin_ctz (tile)] & (tile - 1) & tileGroupParent & ~tileGroup;
+        if (tilesFree) {
+            tileGroup += (tilesFree & -tilesFree) - tile;
+        }
+        tiles -= tile;
+    }
+    return tileGroup;
+}
+
+// Check whether a way to break a group of tiles into 2 smaller groups must be
+// combined: all the ways that only differ by equal tiles have the same
+// canonical groups within the group of tiles, and only the one that uses the
+// lowest of these canonical groups as is gets combined
+inline static Bool IsCanonicalTileSplit (NumbersObject numbersObject, uint32_t tileGroup, uint32_t tileSubGroup) {
+    if (!(tileGroup & numbersObject->duplicates.tileGroup)) {
+        return TRUE;
+    }
+    uint32_t tileSubGroupOther = tileGroup - tileSubGroup;
+    uint32_t tileSubGroupCanonical = GetCanonicalTileGroup (numbersObject, tileSubGroup, tileGroup);
+    uint32_t tileSubGroupOtherCanonical = GetCanonicalTileGroup (numbersObject, tileSubGroupOther, tileGroup);
+    return (tileSubGroup == tileSubGroupCanonical && tileSubGroupCanonical <= tileSubGroupOtherCanonical)
+        || (tileSubGroupOther == tileSubGroupOtherCanonical && tileSubGroupOtherCanonical <= tileSubGroupCanonical) ? TRUE : FALSE;
+}
+
+// Share the operations of the canonical groups of tiles of the current layer
+// with the groups of tiles that are equivalent to them
+static void AliasTileGroups (NumbersObject numbersObject, OperationGroup* operationGroups) {
+    if (!numbersObject->duplicates.tileGroup) {
+        return;
+    }
+    uint32_t operationGroupSize = 1 << numbersObject->final.tileCount;
+    uint32_t tileGroup = (1 << numbersObject->current.tileCount) - 1;
+    do {
+        uint32_t tileGroupCanonical = GetCanonicalTileGroup (numbersObject, tileGroup, operationGroupSize - 1);
+        if (tileGroupCanonical != tileGroup) {
+            operationGroups[tileGroup] = operationGroups[tileGroupCanonical];
+        }
+        uint32_t u = tileGroup & -tileGroup;
+        uint32_t v = u + tileGroup;
+        tileGroup = v + (((v ^ tileGroup) / u) >> 2);
+    } while (tileGroup < operationGroupSize);
+}
 
-            // An operation with the same result but a lower complexity is
-            // already recorded...
+// Sort the results of the groups of operations that the final layer can search
+// (for each way to break the final group of tiles into 2 smaller groups, the
+// largest group of operations gets sorted, unless the smallest one is too small
+// for this to be worth it, or an operation could overflow)
+static void SortFinalGroups (NumbersObject numbersObject, OperationGroup* operationGroups) {
+
+    // Make sure there is room to sort all operations
+    Context* context = &numbersObject->context;
+    uint32_t operationCount = context->current.operationIdLast;
+    if (operationCount > numbersObject->sorted.size) {
+        free (numbersObject->sorted.operations);
+        free (numbersObject->sorted.buffer);
+        numbersObject->sorted.operations = malloc (sizeof (numbersObject->sorted.operations[0]) * operationCount);
+        numbersObject->sorted.buffer = malloc (sizeof (numbersObject->sorted.buffer[0]) * operationCount);
+        if (!numbersObject->sorted.operations || !numbersObject->sorted.buffer) {
+            free (numbersObject->sorted.operations);
+            free (numbersObject->sorted.buffer);
+            numbersObject->sorted.operations = NULL;
+            numbersObject->sorted.buffer = NULL;
+            numbersObject->sorted.size = 0;
             return;
         }
+        numbersObject->sorted.size = operationCount;
+    }
+
+    // Go through all the ways to break the final group of tiles into 2 groups
+    uint64_t* sortedOperations = numbersObject->sorted.operations;
+    uint32_t* results = context->operations.results;
+    uint32_t tileGroup = (1 << numbersObject->final.tileCount) - 1;
+    for (uint32_t tileSubGroup = 1; tileSubGroup < tileGroup - tileSubGroup; ++tileSubGroup) {
+        if (!IsCanonicalTileSplit (numbersObject, tileGroup, tileSubGroup)) {
+            continue;
+        }
+        OperationGroup* operationGroupSmall = &operationGroups[tileSubGroup];
+        OperationGroup* operationGroupLarge = &operationGroups[tileGroup - tileSubGroup];
+        if (operationGroupSmall->operationIdLast - operationGroupSmall->operationIdFirst
+            > operationGroupLarge->operationIdLast - operationGroupLarge->operationIdFirst) {
+            OperationGroup* operationGroupSwap = operationGroupSmall;
+            operationGroupSmall = operationGroupLarge;
+            operationGroupLarge = operationGroupSwap;
+        }
+        if (operationGroupSmall->operationIdLast - operationGroupSmall->operationIdFirst < SORTED_GROUP_SIZE_MIN) {
+            continue;
+        }
+
+        // Check the range of results of the smallest group
+        uint32_t resultSmallMin = UINT32_MAX;
+        uint32_t resultSmallMax = 0;
+        for (OperationId operationId = operationGroupSmall->operationIdFirst;
+            operationId < operationGroupSmall->operationIdLast; ++operationId) {
+            uint32_t result = results[operationId];
+            if (resultSmallMin > result) {
+                resultSmallMin = result;
+            }
+            if (resultSmallMax < result) {
+                resultSmallMax = result;
+            }
+        }
+
+        // Sort the largest group
+        for (OperationId operationId = operationGroupLarge->operationIdFirst;
+            operationId < operationGroupLarge->operationIdLast; ++operationId) {
+            sortedOperations[operationId] = ((uint64_t)results[operationId] << 32) | operationId;
+        }
+        uint64_t* sortedOperationFirst = &sortedOperations[operationGroupLarge->operationIdFirst];
+        uint32_t sortedOperationCount = operationGroupLarge->operationIdLast - operationGroupLarge->operationIdFirst;
+        SortOperations (sortedOperationFirst, numbersObject->sorted.buffer, sortedOperationCount);
+
+        // Make sure no operation can overflow, nor divide by 0 (otherwise
+        // results would not be ordered as expected)
+        uint32_t resultLargeMin = sortedOperationFirst[0] >> 32;
+        uint32_t resultLargeMax = sortedOperationFirst[sortedOperationCount - 1] >> 32;
+        if (resultSmallMin && resultLargeMin
+            && (uint64_t)resultSmallMax * resultLargeMax <= UINT32_MAX
+            && (uint64_t)resultSmallMax + resultLargeMax <= UINT32_MAX) {
+            operationGroupLarge->sorted = TRUE;
+        }
+    }
+}
+
+// Search the position of the first result greater than a value in sorted
+// operations
+inline static uint32_t SearchSortedOperations (uint64_t* sortedOperations, uint32_t position, uint32_t positionEnd, uint64_t value) {
+    if (value > UINT32_MAX) {
+        return positionEnd;
+    }
+    while (position < positionEnd) {
+        uint32_t positionMiddle = position + ((positionEnd - position) >> 1);
+        if (sortedOperations[positionMiddle] >> 32 > value) {
+            positionEnd = positionMiddle;
+        } else {
+            position = positionMiddle + 1;
+        }
+    }
+    return position;
+}
+
+// Compute the difference between the result of an operation and the target
+// (without checking whether the operation is valid)
+inline static uint32_t ComputeTargetDiff (Operator op, uint32_t resultA, uint32_t resultB, uint32_t target) {
+    uint32_t resultMax = resultA >= resultB ? resultA : resultB;
+    uint32_t resultMin = resultA >= resultB ? resultB : resultA;
+    uint32_t result;
+    switch (op) {
+        case ADD:
+            result = resultMax + resultMin;
+            break;
+        case SUB:
+            result = resultMax - resultMin;
+            break;
+        case MUL:
+            result = resultMax * resultMin;
+            break;
+        default:
+            result = resultMax / resultMin;
+            break;
+    }
+    return result > target ? result - target : target - result;
+}
+
+// Combine a result with the results of a sorted group, starting from a given
+// position and going down then up, as long as a given operation can give a
+// result which is not further from the target than the best solution so far
+// (the result of this operation shall be monotonic on both sides of the
+// starting position; only this operation gets recorded, the other ones being
+// found by their own scans)
+static void CombineSortedOperations (Context* context, Operator op, OperationId operationIdA, uint32_t resultA, uint32_t positionFirst, uint32_t position, uint32_t positionLast) {
+
+    // Get the operations
+    NumbersObject numbersObject = context->numbersObject;
+    uint64_t* sortedOperations = numbersObject->sorted.operations;
+    uint32_t target = numbersObject->final.target;
+#ifndef DISABLE_COMPLEXITY
+    Operations* operations = &numbersObject->context.operations;
+    uint16_t complexityA = operations->complexities[operationIdA];
+    uint8_t weightA = operations->weights[operationIdA];
+#endif
+
+    // Go down, then up
+    for (uint32_t direction = 0; direction < 2; ++direction) {
+        uint32_t positionCurrent = position;
+        while (direction ? positionCurrent < positionLast : positionCurrent-- > positionFirst) {
+            uint32_t resultB = sortedOperations[positionCurrent] >> 32;
+            if (ComputeTargetDiff (op, resultA, resultB, target) > context->solution.targetDiff) {
+                break;
+            }
+            OperationId operationIdB = (OperationId)sortedOperations[positionCurrent];
+            uint32_t resultMax;
+            uint32_t resultMin;
+#ifndef DISABLE_COMPLEXITY
+            uint16_t complexityAB = complexityA + operations->complexities[operationIdB];
+            if (complexityAB <= numbersObject->current.complexityMax) {
+                OrderResults (context, operationIdA, operationIdB, resultA, resultB, &resultMax, &resultMin);
+                CombineOrderedResults (context, op, resultMax, resultMin, complexityAB, weightA, operations->weights[operationIdB]);
+            } else {
+                StatisticsAdd (context, complexityPruned, 1);
+            }
+#else
+            OrderResults (context, operationIdA, operationIdB, resultA, resultB, &resultMax, &resultMin);
+            CombineOrderedResults (context, op, resultMax, resultMin, 0, 0, 0);
+#endif
+            if (direction) {
+                ++positionCurrent;
+            }
+        }
+    }
+}
+
+// Combine a result with a sorted group of operations, only computing the
+// operations which may give a result close enough to the target (i.e. searching
+// where each operation gets closest to the target)
+static void CombineOperationWithSortedGroup (Context* context, OperationId operationIdA, OperationGroup* operationGroupB) {
+
+    // Get the operations
+    NumbersObject numbersObject = context->numbersObject;
+    uint64_t* sortedOperations = numbersObject->sorted.operations;
+    uint32_t resultA = numbersObject->context.operations.results[operationIdA];
+    uint64_t target = numbersObject->final.target;
+    uint32_t positionFirst = operationGroupB->operationIdFirst;
+    uint32_t positionLast = operationGroupB->operationIdLast;
+
+    // Find the results of the group B equal to the result A (subtractions and
+    // divisions are monotonic on both sides of them)
+    uint32_t positionEqualFirst = SearchSortedOperations (sortedOperations, positionFirst, positionLast, resultA - 1);
+    uint32_t positionEqualLast = SearchSortedOperations (sortedOperations, positionEqualFirst, positionLast, resultA);
+
+    // Addition (increasing with B)
+    uint32_t position = target >= resultA ? SearchSortedOperations (sortedOperations, positionFirst, positionLast, target - resultA) : positionFirst;
+    CombineSortedOperations (context, ADD, operationIdA, resultA, positionFirst, position, positionLast);
+
+    // Multiplication (increasing with B)
+    position = SearchSortedOperations (sortedOperations, positionFirst, positionLast, target / resultA);
+    CombineSortedOperations (context, MUL, operationIdA, resultA, positionFirst, position, positionLast);
+
+    // Subtraction and division when B is lower than A (decreasing with B)
+    position = resultA >= target ? SearchSortedOperations (sortedOperations, positionFirst, positionEqualFirst, resultA - target) : positionFirst;
+    CombineSortedOperations (context, SUB, operationIdA, resultA, positionFirst, position, positionEqualFirst);
+    position = target ? SearchSortedOperations (sortedOperations, positionFirst, positionEqualFirst, resultA / target) : positionEqualFirst;
+    CombineSortedOperations (context, DIV, operationIdA, resultA, positionFirst, position, positionEqualFirst);
+
+    // Subtraction and division when B is greater than A (increasing with B)
+    position = SearchSortedOperations (sortedOperations, positionEqualLast, positionLast, resultA + target);
+    CombineSortedOperations (context, SUB, operationIdA, resultA, positionEqualLast, position, positionLast);
+    position = SearchSortedOperations (sortedOperations, positionEqualLast, positionLast, resultA * (target + 1) - 1);
+    CombineSortedOperations (context, DIV, operationIdA, resultA, positionEqualLast, position, positionLast);
+
+    // Results equal to A
+    CombineSortedOperations (context, DIV, operationIdA, resultA, positionEqualFirst, positionEqualFirst, positionEqualLast);
+}
+
+// Combine 2 groups of operations, computing all possible combinations of their
+// results
+static void CombineOperationGroups (Context* context, OperationGroup* operationGroupA, OperationGroup* operationGroupB) {
+
+    // Get the operations (all groups to combine were recorded in the object
+    // during previous layers)
+    // Note: the arrays may grow (and move) whenever an operation is recorded
+    // in the context of the object, hence the need to always access them
+    // through the context
+    NumbersObject numbersObject = context->numbersObject;
+    Operations* operations = &numbersObject->context.operations;
+
+    // In the final layer, search the results of a sorted group rather than
+    // combining them all
+    if (operationGroupA->sorted || operationGroupB->sorted) {
+        if (operationGroupA->sorted) {
+            OperationGroup* operationGroupSwap = operationGroupA;
+            operationGroupA = operationGroupB;
+            operationGroupB = operationGroupSwap;
+        }
+        for (OperationId operationIdA = operationGroupA->operationIdFirst;
+            operationIdA < operationGroupA->operationIdLast; ++operationIdA) {
+            CombineOperationWithSortedGroup (context, operationIdA, operationGroupB);
+        }
+        return;
+    }
+
+    // Go through all results of the group A
+    for (OperationId operationIdA = operationGroupA->operationIdFirst;
+        operationIdA < operationGroupA->operationIdLast; ++operationIdA) {
+
+        // Get information about this result
+        uint32_t resultA = operations->results[operationIdA];
+#ifndef DISABLE_COMPLEXITY
+        uint8_t weightA = operations->weights[operationIdA];
+        uint16_t complexityA = operations->complexities[operationIdA];
+#endif
+
+        // Go through all results of the group B, by blocks first
+        OperationId operationIdB = operationGroupB->operationIdFirst;
+#ifdef VECTOR_WIDTH
+        for (; operationIdB + VECTOR_WIDTH <= operationGroupB->operationIdLast; operationIdB += VECTOR_WIDTH) {
+#ifndef DISABLE_COMPLEXITY
+            CombineOperationBlock (context, operationIdA, operationIdB,
+                resultA, &operations->results[operationIdB],
+                complexityA, &operations->complexities[operationIdB],
+                weightA, &operations->weights[operationIdB]);
+#else
+            CombineOperationBlock (context, operationIdA, operationIdB,
+                resultA, &operations->results[operationIdB], 0, NULL, 0, NULL);
+#endif
+        }
+#endif
+        for (; operationIdB < operationGroupB->operationIdLast; ++operationIdB) {
+
+            // Compute the overall complexity to get that far
+#ifndef DISABLE_COMPLEXITY
+            uint16_t complexityAB = complexityA + operations->complexities[operationIdB];
+            if (complexityAB > numbersObject->current.complexityMax) {
+                StatisticsAdd (context, complexityPruned, 1);
+                continue;
+            }
+            CombineOperations (context, operationIdA, operationIdB,
+                resultA, operations->results[operationIdB], complexityAB, weightA, operations->weights[operationIdB]);
+#else
+            CombineOperations (context, operationIdA, operationIdB,
+                resultA, operations->results[operationIdB], 0, 0, 0);
+#endif
+        }
+    }
+}
+
+// Combine the operation groups of some of the ways to break a group of tiles
+// into 2 smaller groups (this function is always inlined, so that it gets
+// specialized when the number of tiles of the group is a constant)
+__attribute__((always_inline)) inline static void CombineTileSubGroups (Context* context, OperationGroup* operationGroups, uint32_t tileGroup, uint32_t tileCount, uint32_t tileSubGroupIdFirst, uint32_t tileSubGroupIdLast) {
+
+    // Get the plan to break this group of tiles into 2 smaller groups (it is
+    // computed once for small groups)
+    uint16_t* tileSubGroups;
+    uint16_t tileSubGroupsComputed[tileGroup < (1 << SPLIT_PLAN_TILE_COUNT_MAX) ? 1 : (1 << (tileCount - 1)) - 1];
+    if (tileGroup < (1 << SPLIT_PLAN_TILE_COUNT_MAX)) {
+        tileSubGroups = &splitPlans.tileSubGroups[splitPlans.offsets[tileGroup]];
+    } else {
+        SplitPlanCompute (tileGroup, tileSubGroupsComputed);
+        tileSubGroups = tileSubGroupsComputed;
+    }
+
+    // Combine all pairs of smaller groups
+    NumbersObject numbersObject = context->numbersObject;
+    for (uint32_t tileSubGroupId = tileSubGroupIdFirst;
+        tileSubGroupId < tileSubGroupIdLast && !context->solution.aborted && !IsSearchOver (numbersObject, context);
+        ++tileSubGroupId) {
+        uint32_t tileSubGroup = tileSubGroups[tileSubGroupId];
+        if (!IsCanonicalTileSplit (numbersObject, tileGroup, tileSubGroup)) {
+            continue;
+        }
+        OperationGroup* operationGroupA = &operationGroups[tileSubGroup];
+        OperationGroup* operationGroupB = &operationGroups[tileGroup - tileSubGroup];
+#ifndef DISABLE_COMPLEXITY
+
+        // Once the target has been reached, only combine groups that could
+        // reach it with a lower complexity
+        if (context->solution.targetDiff == 0 && numbersObject->final.tileCountPruning
+            && (uint32_t)operationGroupA->complexityMin + operationGroupB->complexityMin >= context->solution.complexity) {
+            continue;
+        }
+#endif
+
+        // Stop the search when it exceeds its limits (if any)
+        if (numbersObject->limits.enabled && IsLimitExceeded (numbersObject,
+            (uint64_t)(operationGroupA->operationIdLast - operationGroupA->operationIdFirst)
+                * (operationGroupB->operationIdLast - operationGroupB->operationIdFirst))) {
+            context->solution.aborted = TRUE;
+            break;
+        }
+        CombineOperationGroups (context, operationGroupA, operationGroupB);
+    }
+}
+
+// Process work items until there are none left
+static void WorkerProcessItems (Worker* worker) {
+
+    // Operations recorded by the worker are given IDs following the ones of
+    // the operations already recorded in the object
+    NumbersObject numbersObject = worker->context.numbersObject;
+    Context* context = &worker->context;
+    context->operationIdBase = numbersObject->context.current.operationIdLast;
+    context->current.operationIdLast = context->operationIdBase;
+
+    // Process the items
+    uint32_t itemId;
+    while ((itemId = atomic_fetch_add (&numbersObject->threads.itemNext, 1)) < numbersObject->threads.itemCount) {
+        WorkItem* item = &numbersObject->threads.items[itemId];
+
+        // Start from the best solution found in previous layers, to make sure
+        // the result does not depend on the order in which items get processed
+        context->solution = numbersObject->context.solution;
+
+        // Combine the groups of operations (unless the search is over in a
+        // previous item)
+        context->current.operationIdFirst = context->current.operationIdLast;
+        if (itemId < atomic_load (&numbersObject->threads.itemOver)) {
+            CombineTileSubGroups (context, numbersObject->threads.operationGroups,
+                item->tileGroup, numbersObject->current.tileCount, item->tileSubGroupIdFirst, item->tileSubGroupIdLast);
+            RecordFinalOperation (context);
+
+            // Let the other workers know when the search is over
+            if (IsSearchOver (numbersObject, context)) {
+                uint32_t itemIdOver = atomic_load (&numbersObject->threads.itemOver);
+                while (itemId < itemIdOver
+                    && !atomic_compare_exchange_weak (&numbersObject->threads.itemOver, &itemIdOver, itemId)) {
+                }
+            }
+        }
+
+        // Take note of the results
+        item->workerId = worker->workerId;
+        item->operationIdFirst = context->current.operationIdFirst;
+        item->operationIdLast = context->current.operationIdLast;
+        item->solution = context->solution;
+    }
+}
+
+// Worker thread start routine
+static void* WorkerRun (void* data) {
+
+    // Wait for some work, until the object gets shut down
+    Worker* worker = (Worker*)data;
+    NumbersObject numbersObject = worker->context.numbersObject;
+    uint32_t generation = 0;
+    pthread_mutex_lock (&numbersObject->threads.mutex);
+    while (1) {
+        while (numbersObject->threads.generation == generation && !numbersObject->threads.shutdown) {
+            pthread_cond_wait (&numbersObject->threads.start, &numbersObject->threads.mutex);
+        }
+        if (numbersObject->threads.shutdown) {
+            break;
+        }
+        generation = numbersObject->threads.generation;
+        pthread_mutex_unlock (&numbersObject->threads.mutex);
+
+        // Work!
+        WorkerProcessItems (worker);
+
+        // Inform the thread calling NumbersSolve
+        pthread_mutex_lock (&numbersObject->threads.mutex);
+        if (--numbersObject->threads.busyCount == 0) {
+            pthread_cond_signal (&numbersObject->threads.done);
+        }
+    }
+    pthread_mutex_unlock (&numbersObject->threads.mutex);
+    return NULL;
+}
+
+// Combine all groups of operations of the current layer, using all worker
+// threads
+static void CombineLayerInParallel (NumbersObject numbersObject, OperationGroup* operationGroups) {
+
+    // Define the work items: there is an item per group of tiles (except for
+    // groups equivalent to other ones), except in the final layer, which has a
+    // single group of tiles that gets split into several items
+    uint32_t operationGroupSize = 1 << numbersObject->final.tileCount;
+    uint32_t tileSubGroupCount = (1 << (numbersObject->current.tileCount - 1)) - 1;
+    uint32_t itemPerGroupCount = 1;
+    if (numbersObject->current.tileCount == numbersObject->final.tileCount) {
+        itemPerGroupCount = numbersObject->threads.workerCount << 2;
+        if (itemPerGroupCount > tileSubGroupCount) {
+            itemPerGroupCount = tileSubGroupCount;
+        }
+    }
+    WorkItem* items = numbersObject->items;
+    uint32_t itemCount = 0;
+    uint32_t tileGroup = (1 << numbersObject->current.tileCount) - 1;
+    do {
+        uint32_t itemPerGroupLast = IsCanonicalTileGroup (numbersObject, tileGroup, operationGroupSize - 1) ? itemPerGroupCount : 0;
+        for (uint32_t itemPerGroupId = 0; itemPerGroupId < itemPerGroupLast; ++itemPerGroupId) {
+            WorkItem* item = &items[itemCount++];
+            item->tileGroup = tileGroup;
+            item->tileSubGroupIdFirst = tileSubGroupCount * itemPerGroupId / itemPerGroupCount;
+            item->tileSubGroupIdLast = tileSubGroupCount * (itemPerGroupId + 1) / itemPerGroupCount;
+        }
+        uint32_t u = tileGroup & -tileGroup;
+        uint32_t v = u + tileGroup;
+        tileGroup = v + (((v ^ tileGroup) / u) >> 2);
+    } while (tileGroup < operationGroupSize);
+
+    // Wake up the worker threads
+    pthread_mutex_lock (&numbersObject->threads.mutex);
+    numbersObject->threads.operationGroups = operationGroups;
+    numbersObject->threads.items = items;
+    numbersObject->threads.itemCount = itemCount;
+    atomic_store (&numbersObject->threads.itemNext, 0);
+    atomic_store (&numbersObject->threads.itemOver, itemCount);
+    numbersObject->threads.busyCount = numbersObject->threads.workerCount - 1;
+    ++numbersObject->threads.generation;
+    pthread_cond_broadcast (&numbersObject->threads.start);
+    pthread_mutex_unlock (&numbersObject->threads.mutex);
+
+    // Work, then wait for all worker threads to complete
+    WorkerProcessItems (&numbersObject->threads.workers[0]);
+    pthread_mutex_lock (&numbersObject->threads.mutex);
+    while (numbersObject->threads.busyCount) {
+        pthread_cond_wait (&numbersObject->threads.done, &numbersObject->threads.mutex);
+    }
+    pthread_mutex_unlock (&numbersObject->threads.mutex);
+
+    // Gather the operations recorded by all workers, in the order of the
+    // items (so that the result is the same as when solving on a single
+    // thread), up to the item in which the search is over (if any)
+    Context* context = &numbersObject->context;
+    OperationId operationIdBase = context->current.operationIdLast;
+    uint32_t itemIdOver = atomic_load (&numbersObject->threads.itemOver);
+    for (uint32_t itemId = 0; itemId < itemCount && itemId <= itemIdOver && !context->solution.aborted; ++itemId) {
+        WorkItem* item = &items[itemId];
+        Context* workerContext = &numbersObject->threads.workers[item->workerId].context;
+
+        // Make sure the operations can be copied
+        uint32_t operationCount = item->operationIdLast - item->operationIdFirst;
+        uint32_t operationSize = context->current.operationIdLast + operationCount;
+        if (operationSize > context->operationSize && !ContextGrow (context, operationSize)) {
+            context->solution.aborted = TRUE;
+            break;
+        }
+
+        // Copy the operations
+        OperationId operationId = context->current.operationIdLast;
+        OperationsCopy (&context->operations, operationId,
+            &workerContext->operations, item->operationIdFirst - workerContext->operationIdBase, operationCount);
+        context->current.operationIdLast += operationCount;
+
+        // Record the operation group
+        OperationGroup* operationGroup = &operationGroups[item->tileGroup];
+        if (item->tileSubGroupIdFirst == 0) {
+            operationGroup->operationIdFirst = operationId;
+#ifndef DISABLE_COMPLEXITY
+            operationGroup->complexityMin = UINT16_MAX;
+#endif
+        }
+        operationGroup->operationIdLast = context->current.operationIdLast;
+#ifndef DISABLE_COMPLEXITY
+        operationGroup->complexityMin = GetComplexityMin (context, operationId,
+            context->current.operationIdLast, operationGroup->complexityMin);
+#endif
+
+        // Take note of the best solution so far
+        if (item->solution.operationId >= operationIdBase
+            && item->solution.operationId != OPERATION_ID_NONE
+            && IsBetterSolution (&item->solution, &context->solution)) {
+            context->solution = item->solution;
+            context->solution.operationId += operationId - item->operationIdFirst;
+        }
+        context->solution.aborted = item->solution.aborted;
+    }
+}
+
+// Generate the solution (using the extended encoding; the operations of groups
+// of tiles equivalent to other ones refer to the tiles of these other groups,
+// so tiles already used get replaced with unused tiles having the same value)
+static OperationId GenerateSolution (OperationOrigin* origins, uint32_t* duplicateTileGroups, OperationId operationId, uint16_t** solutionOperations, uint32_t* tileGroupUsed) {
+
+    // Make sure there is an operation
+    OperationOrigin* origin = &origins[operationId];
+    if (origin->op == NOP) {
+        uint32_t tilesFree = duplicateTileGroups[operationId] & ~*tileGroupUsed;
+        operationId = __builtin_ctz (tilesFree);
+        *tileGroupUsed |= 1 << operationId;
+        return operationId;
+    }
+
+    // Track back...
+    OperationId tileIdLeft = GenerateSolution (origins, duplicateTileGroups, origin->operationIdLeft, solutionOperations, tileGroupUsed);
+    OperationId tileIdRight = GenerateSolution (origins, duplicateTileGroups, origin->operationIdRight, solutionOperations, tileGroupUsed);
+
+    // Append the operation to the solution
+    **solutionOperations = tileIdLeft | (tileIdRight << 4) | (origin->op << 8);
+    ++*solutionOperations;
+
+    // Assume the result will be stored in the left tile
+    return tileIdLeft;
+}
+
+// Convert a solution from the extended encoding to the compact one
+static void ConvertSolution (uint16_t* solutionOperationsExtended, uint8_t* solutionOperations) {
+    do {
+        uint16_t operationEncoded = *solutionOperationsExtended;
+        *solutionOperations++ = (operationEncoded & 7) | ((operationEncoded >> 1) & (7 << 3)) | ((operationEncoded >> 2) & (3 << 6));
+    } while (*solutionOperationsExtended++);
+}
+
+// Number of tiles for which the search gets specialized (i.e. compiled with
+// a constant number of tiles; 0 to disable the specialization)
+#ifndef SEARCH_TILE_COUNT_SPECIALIZED
+#define SEARCH_TILE_COUNT_SPECIALIZED 6
+#endif
+
+// Search for the solution with a given number of tiles (this function is
+// always inlined, so that it gets specialized when the number of tiles is a
+// constant: the size of the array of groups, the number of ways to break each
+// group of tiles, and the bounds of all loops on layers and groups are then
+// known by the compiler)
+__attribute__((always_inline)) inline static NumbersError SearchTiles (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint32_t tileCount, uint16_t complexityMax, Bool exhaustive) {
+
+    // Make sure the groups of operations can be recorded
+    if (!TileArraysReserve (numbersObject, tileCount)) {
+        return MemoryAllocationError;
+    }
+
+    // Take note of the target and number of tiles
+    numbersObject->final.target = target;
+    numbersObject->final.tileCount = tileCount;
+    numbersObject->final.tileCountPruning = exhaustive ? 0 : tileCount;
+
+    // Initialize the solution
+    Context* context = &numbersObject->context;
+    context->solution.operationId = OPERATION_ID_NONE;
+    context->solution.targetDiff = UINT32_MAX;
+    context->solution.aborted = FALSE;
+    context->final.pending = FALSE;
+    atomic_store (&numbersObject->limits.operationCount, 0);
+    atomic_store (&numbersObject->limits.exceeded, FALSE);
+
+    // Get rid of the operation IDs of the previous call in the hash sets (as
+    // well as of its statistics)
+    ContextClearHashes (context);
+    for (uint32_t workerId = 0; workerId < numbersObject->threads.workerCount; ++workerId) {
+        ContextClearHashes (&numbersObject->threads.workers[workerId].context);
+#ifdef ENABLE_STATISTICS
+        memset (&numbersObject->threads.workers[workerId].context.statistics, 0, sizeof (context->statistics));
+#endif
+    }
+#ifdef ENABLE_STATISTICS
+    memset (&context->statistics, 0, sizeof (context->statistics));
+#endif
+    NumbersStatistics* statistics = &numbersObject->statistics;
+    memset (statistics, 0, sizeof (*statistics));
+
+    // Get the array to record groups of operations (1 group per combination of
+    // tiles; all groups remain empty until they get combined, in case the
+    // search gets aborted)
+    uint32_t operationGroupSize = 1 << tileCount;
+    OperationGroup* operationGroups = numbersObject->operationGroups;
+    memset (operationGroups, 0, sizeof (operationGroups[0]) * operationGroupSize);
+
+    // Record all the tiles
+    numbersObject->current.tileCount = 1;
+#ifndef DISABLE_COMPLEXITY
+    numbersObject->current.complexityMax = complexityMax;
+#endif
+    context->current.operationIdLast = 0;
+    for (uint32_t tileId = 0; tileId < tileCount; ++tileId) {
+
+        // Record the tile
+        context->current.operationIdFirst = context->current.operationIdLast;
+        RecordOperation (context, NOP, tiles->values[tileId], 0);
+        RecordFinalOperation (context);
+
+        // This tile alone defines a new operation group
+        uint32_t tileGroup = 1 << tileId;
+        operationGroups[tileGroup].operationIdFirst = context->current.operationIdFirst;
+        operationGroups[tileGroup].operationIdLast = context->current.operationIdLast;
+    }
+    statistics->operationCounts[0] = context->current.operationIdLast;
+
+    // Find the equal tiles
+    numbersObject->duplicates.tileGroup = 0;
+    for (uint32_t tileId = 0; tileId < tileCount; ++tileId) {
+        numbersObject->duplicates.tileGroups[tileId] = 0;
+        for (uint32_t tileIdOther = 0; tileIdOther < tileCount; ++tileIdOther) {
+            if (tiles->values[tileIdOther] == tiles->values[tileId]) {
+                numbersObject->duplicates.tileGroups[tileId] |= 1 << tileIdOther;
+                if (tileIdOther < tileId) {
+                    numbersObject->duplicates.tileGroup |= 1 << tileId;
+                }
+            }
+        }
+    }
+
+    // Perform all possible tile combinations, starting with just 2 tiles then
+    // adding some more
+    for (uint32_t layerTileCount = 2; layerTileCount <= tileCount
+        && (context->solution.targetDiff != 0 || exhaustive)
+        && !context->solution.aborted; ++layerTileCount) {
+
+        // Increase the number of tiles to include in the combination
+        numbersObject->current.tileCount = layerTileCount;
+        OperationId operationIdLayerFirst = context->current.operationIdLast;
+
+        // In the final layer, sort the groups of operations that can be
+        // searched
+        if (layerTileCount == numbersObject->final.tileCountPruning) {
+            SortFinalGroups (numbersObject, operationGroups);
+        }
+
+        // Let the worker threads deal with this layer (if any)
+        if (numbersObject->threads.workerCount) {
+            CombineLayerInParallel (numbersObject, operationGroups);
+            AliasTileGroups (numbersObject, operationGroups);
+            statistics->operationCounts[layerTileCount - 1] = context->current.operationIdLast - operationIdLayerFirst;
+            continue;
+        }
+
+        // Define a group with the number of tiles specified
+        uint32_t tileGroup = (1 << layerTileCount) - 1;
+        uint32_t tileSubGroupCount = (1 << (layerTileCount - 1)) - 1;
+        do {
+
+            // Combine all pairs of smaller groups (unless the group is
+            // equivalent to another one)
+            if (IsCanonicalTileGroup (numbersObject, tileGroup, operationGroupSize - 1)) {
+                context->current.operationIdFirst = context->current.operationIdLast;
+                CombineTileSubGroups (context, operationGroups, tileGroup, layerTileCount, 0, tileSubGroupCount);
+                RecordFinalOperation (context);
+
+                // Record this new operation group
+                operationGroups[tileGroup].operationIdFirst = context->current.operationIdFirst;
+                operationGroups[tileGroup].operationIdLast = context->current.operationIdLast;
+#ifndef DISABLE_COMPLEXITY
+                operationGroups[tileGroup].complexityMin = GetComplexityMin (context,
+                    context->current.operationIdFirst, context->current.operationIdLast, UINT16_MAX);
+#endif
+            }
+
+            // Next group of tiles (with the same number of tiles)
+            uint32_t u = tileGroup & -tileGroup;
+            uint32_t v = u + tileGroup;
+            tileGroup = v + (((v ^ tileGroup) / u) >> 2);
+        } while (tileGroup < operationGroupSize && !context->solution.aborted && !IsSearchOver (numbersObject, context));
+        AliasTileGroups (numbersObject, operationGroups);
+        statistics->operationCounts[layerTileCount - 1] = context->current.operationIdLast - operationIdLayerFirst;
+    }
+
+    // Take note of the statistics of the search
+    statistics->operationIdPeak = context->current.operationIdLast;
+    statistics->abortedTileCount = context->solution.aborted ? numbersObject->current.tileCount : 0;
+#ifdef ENABLE_STATISTICS
+    for (uint32_t workerId = 0; workerId <= numbersObject->threads.workerCount; ++workerId) {
+        Context* contextCounted = workerId ? &numbersObject->threads.workers[workerId - 1].context : context;
+        statistics->duplicateHits += contextCounted->statistics.duplicateHits;
+        statistics->duplicateMisses += contextCounted->statistics.duplicateMisses;
+        statistics->outsideResults += contextCounted->statistics.outsideResults;
+        statistics->complexityPruned += contextCounted->statistics.complexityPruned;
+    }
+#endif
+    if (atomic_load (&numbersObject->limits.exceeded)) {
+        return InterruptedError;
+    }
+    return context->solution.aborted ? AbortedError : Success;
+}
+
+// Search for the solution (or record all possible operations when the search
+// is exhaustive, instead of stopping as soon as the target is reached)
+static NumbersError Search (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t complexityMax, Bool exhaustive) {
+#if SEARCH_TILE_COUNT_SPECIALIZED
+    if (tiles->count == SEARCH_TILE_COUNT_SPECIALIZED) {
+        return SearchTiles (numbersObject, target, tiles, SEARCH_TILE_COUNT_SPECIALIZED, complexityMax, exhaustive);
+    }
+#endif
+    return SearchTiles (numbersObject, target, tiles, tiles->count, complexityMax, exhaustive);
+}
+
+// Solve the game (the solution is generated using the extended encoding)
+static NumbersError Solve (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint16_t* solutionOperations, uint32_t* result) {
+
+    // Search for the solution
+    NumbersError error = Search (numbersObject, target, tiles, complexity ? *complexity : UINT16_MAX, FALSE);
+    if (error != Success && error != AbortedError && error != InterruptedError) {
+        return error;
+    }
+
+    // Make sure a solution has been found
+    Context* context = &numbersObject->context;
+    if (context->solution.operationId == OPERATION_ID_NONE) {
+        if (solutionOperations) {
+            *solutionOperations = 0;
+        }
+        if (complexity) {
+            *complexity = 0;
+        }
+        if (result) {
+            *result = 0;
+        }
+    } else {
+
+        // Generate the solution
+        if (solutionOperations) {
+            uint32_t tileGroupUsed = 0;
+            GenerateSolution (context->operations.origins, numbersObject->duplicates.tileGroups,
+                context->solution.operationId, &solutionOperations, &tileGroupUsed);
+            *solutionOperations = 0;
+        }
+        if (complexity) {
+#ifndef DISABLE_COMPLEXITY
+            *complexity = context->operations.complexities[context->solution.operationId];
+#else
+            *complexity = 0;
+#endif
+        }
+        if (result) {
+            *result = context->operations.results[context->solution.operationId];
+        }
+    }
+    return error;
+}
+
+// Solve the game
+extern NumbersError NumbersSolve (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result) {
+
+    // Check the pointers
+    if (!numbersObject || !tiles) {
+        return NullPointerError;
+    }
+
+    // Let the variant of the library that initialized the object deal with it
+    // (if it isn't this one)
+    if (numbersObject->variant != &variant) {
+        return numbersObject->variant->solve (numbersObject, target, tiles, complexity, solutionOperations, result);
+    }
+    if (tiles->count > 8) {
+        return TooManyTilesError;
+    }
+
+    // Solve the game
+    uint16_t solutionOperationsExtended[NUMBERS_TILE_COUNT_MAX];
+    NumbersError error = Solve (numbersObject, target, tiles, complexity, solutionOperations ? solutionOperationsExtended : NULL, result);
+
+    // Convert the solution to the compact encoding
+    if (solutionOperations && (error == Success || error == AbortedError)) {
+        ConvertSolution (solutionOperationsExtended, solutionOperations);
+    }
+    return error;
+}
+
+// Solve the game (supporting more tiles)
+extern NumbersError NumbersSolveExtended (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint16_t* solutionOperations, uint32_t* result) {
+
+    // Check the pointers
+    if (!numbersObject || !tiles) {
+        return NullPointerError;
+    }
+
+    // Let the variant of the library that initialized the object deal with it
+    // (if it isn't this one)
+    if (numbersObject->variant != &variant) {
+        return numbersObject->variant->solveExtended (numbersObject, target, tiles, complexity, solutionOperations, result);
+    }
+    if (tiles->count > NUMBERS_TILE_COUNT_MAX) {
+        return TooManyTilesError;
+    }
+
+    // Solve the game
+    return Solve (numbersObject, target, tiles, complexity, solutionOperations, result);
+}
+
+// Solve the game, within some limits
+extern NumbersError NumbersSolveWithLimits (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, NumbersLimits* limits, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result) {
+
+    // Check the pointers
+    if (!numbersObject || !tiles || !limits) {
+        return NullPointerError;
+    }
+
+    // Let the variant of the library that initialized the object deal with it
+    // (if it isn't this one)
+    if (numbersObject->variant != &variant) {
+        return numbersObject->variant->solveWithLimits (numbersObject, target, tiles, limits, complexity, solutionOperations, result);
+    }
+    if (tiles->count > 8) {
+        return TooManyTilesError;
+    }
+
+    // Set the limits
+    numbersObject->limits.enabled = TRUE;
+    numbersObject->limits.deadline = limits->timeLimit ? GetTime () + (uint64_t)limits->timeLimit * 1000 : 0;
+    numbersObject->limits.operationBudget = limits->operationBudget;
+    numbersObject->limits.cancel = limits->cancel;
+
+    // Solve the game
+    uint16_t solutionOperationsExtended[NUMBERS_TILE_COUNT_MAX];
+    NumbersError error = Solve (numbersObject, target, tiles, complexity, solutionOperations ? solutionOperationsExtended : NULL, result);
+    numbersObject->limits.enabled = FALSE;
+
+    // Convert the solution to the compact encoding
+    if (solutionOperations && (error == Success || error == AbortedError || error == InterruptedError)) {
+        ConvertSolution (solutionOperationsExtended, solutionOperations);
+    }
+    return error;
+}
+
+// Get the statistics of the last search
+extern NumbersError NumbersGetStatistics (NumbersObject numbersObject, NumbersStatistics* statistics) {
+
+    // Check the pointers
+    if (!numbersObject || !statistics) {
+        return NullPointerError;
+    }
+
+    // Let the variant of the library that initialized the object deal with it
+    // (if it isn't this one)
+    if (numbersObject->variant != &variant) {
+        return numbersObject->variant->getStatistics (numbersObject, statistics);
+    }
+
+    // Copy the statistics
+    *statistics = numbersObject->statistics;
+    return Success;
+}
+
+// Initialize a cache
+extern NumbersError NumbersCacheInitialize (uint32_t entryCount, NumbersCacheObject* cacheObject_) {
+
+    // Check the pointer
+    if (!cacheObject_) {
+        return NullPointerError;
+    }
+    *cacheObject_ = NULL;
+
+    // Check the size
+    if (!entryCount) {
+        return ZeroSizeError;
+    }
+
+    // Allocate an object
+    NumbersCacheObject cacheObject = malloc (sizeof (struct NumbersCacheStruct));
+    if (!cacheObject) {
+        return MemoryAllocationError;
+    }
+
+    // Allocate the entries of all shards (rounding up the number of entries)
+    cacheObject->setCount = (entryCount + CACHE_SHARD_COUNT * CACHE_WAY_COUNT - 1) / (CACHE_SHARD_COUNT * CACHE_WAY_COUNT);
+    for (uint32_t shardId = 0; shardId < CACHE_SHARD_COUNT; ++shardId) {
+        CacheShard* shard = &cacheObject->shards[shardId];
+        shard->age = 0;
+        shard->entries = calloc (cacheObject->setCount * CACHE_WAY_COUNT, sizeof (shard->entries[0]));
+        if (!shard->entries || pthread_mutex_init (&shard->mutex, NULL)) {
+            NumbersError error = shard->entries ? ThreadError : MemoryAllocationError;
+            free (shard->entries);
+            while (shardId--) {
+                pthread_mutex_destroy (&cacheObject->shards[shardId].mutex);
+                free (cacheObject->shards[shardId].entries);
+            }
+            free (cacheObject);
+            return error;
+        }
+    }
+
+    // Return the object
+    *cacheObject_ = cacheObject;
+
+    // Done
+    return Success;
+}
+
+// Shut down a cache
+extern NumbersError NumbersCacheShutdown (NumbersCacheObject cacheObject) {
+
+    // Check the pointer
+    if (!cacheObject) {
+        return NullPointerError;
+    }
+
+    // Destroy the object
+    for (uint32_t shardId = 0; shardId < CACHE_SHARD_COUNT; ++shardId) {
+        pthread_mutex_destroy (&cacheObject->shards[shardId].mutex);
+        free (cacheObject->shards[shardId].entries);
+    }
+    free (cacheObject);
+
+    // Done
+    return Success;
+}
+
+// Check whether a cache entry records a given problem
+inline static Bool CacheEntryMatch (CacheEntry* entry, CacheEntry* problem) {
+    return entry->used
+        && entry->hash == problem->hash
+        && entry->target == problem->target
+        && entry->complexityMax == problem->complexityMax
+        && entry->complexityDisabled == problem->complexityDisabled
+        && entry->overflowChecked == problem->overflowChecked
+        && entry->tileCount == problem->tileCount
+        && !memcmp (entry->tileValues, problem->tileValues, sizeof (problem->tileValues[0]) * problem->tileCount)
+        ? TRUE : FALSE;
+}
+
+// Solve the game, using a cache
+extern NumbersError NumbersSolveCached (NumbersObject numbersObject, NumbersCacheObject cacheObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result) {
+
+    // Check the pointers
+    if (!numbersObject || !cacheObject || !tiles) {
+        return NullPointerError;
+    }
+    if (tiles->count > 8) {
+        return TooManyTilesError;
+    }
+
+    // Sort the tiles (insertion sort), keeping track of their original IDs
+    CacheEntry problem;
+    uint8_t tileIds[8];
+    for (uint32_t tileId = 0; tileId < tiles->count; ++tileId) {
+        uint32_t tileValue = tiles->values[tileId];
+        uint32_t tileSortedId = tileId;
+        while (tileSortedId && problem.tileValues[tileSortedId - 1] > tileValue) {
+            problem.tileValues[tileSortedId] = problem.tileValues[tileSortedId - 1];
+            tileIds[tileSortedId] = tileIds[tileSortedId - 1];
+            --tileSortedId;
+        }
+        problem.tileValues[tileSortedId] = tileValue;
+        tileIds[tileSortedId] = tileId;
+    }
+    problem.tileCount = tiles->count;
+    problem.target = target;
+    problem.complexityMax = complexity ? *complexity : UINT16_MAX;
+    problem.complexityDisabled = numbersObject->complexityDisabled;
+    problem.overflowChecked = numbersObject->overflowChecked;
+
+    // Hash the problem (FNV-1a)
+    uint32_t hash = 2166136261U;
+    hash = (hash ^ problem.target) * 16777619U;
+    hash = (hash ^ problem.complexityMax) * 16777619U;
+    hash = (hash ^ problem.complexityDisabled) * 16777619U;
+    hash = (hash ^ problem.overflowChecked) * 16777619U;
+    for (uint32_t tileId = 0; tileId < problem.tileCount; ++tileId) {
+        hash = (hash ^ problem.tileValues[tileId]) * 16777619U;
+    }
+    problem.hash = hash;
+    CacheShard* shard = &cacheObject->shards[hash % CACHE_SHARD_COUNT];
+    CacheEntry* entries = &shard->entries[(hash / CACHE_SHARD_COUNT) % cacheObject->setCount * CACHE_WAY_COUNT];
+
+    // Search for the problem in the cache
+    NumbersError error = AbortedError;
+    pthread_mutex_lock (&shard->mutex);
+    for (uint32_t wayId = 0; wayId < CACHE_WAY_COUNT; ++wayId) {
+        CacheEntry* entry = &entries[wayId];
+        if (CacheEntryMatch (entry, &problem)) {
+            entry->age = ++shard->age;
+            problem.complexity = entry->complexity;
+            problem.result = entry->result;
+            memcpy (problem.solutionOperations, entry->solutionOperations, sizeof (problem.solutionOperations));
+            error = Success;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&shard->mutex);
+
+    // Solve the problem if it isn't in the cache (without holding the lock)
+    if (error != Success) {
+        NumbersTiles tilesSorted = {problem.tileCount, problem.tileValues};
+        problem.complexity = problem.complexityMax;
+        error = NumbersSolve (numbersObject, target, &tilesSorted, &problem.complexity, problem.solutionOperations, &problem.result);
+        if (error != Success && error != AbortedError) {
+            return error;
+        }
+
+        // Record the solution, unless the search was aborted (replacing the
+        // least recently used entry of the set)
+        if (error == Success) {
+            pthread_mutex_lock (&shard->mutex);
+            CacheEntry* entryReplaced = &entries[0];
+            for (uint32_t wayId = 0; wayId < CACHE_WAY_COUNT; ++wayId) {
+                CacheEntry* entry = &entries[wayId];
+                if (CacheEntryMatch (entry, &problem) || !entry->used) {
+                    entryReplaced = entry;
+                    break;
+                }
+                if (entry->age < entryReplaced->age) {
+                    entryReplaced = entry;
+                }
+            }
+            *entryReplaced = problem;
+            entryReplaced->used = TRUE;
+            entryReplaced->age = ++shard->age;
+            pthread_mutex_unlock (&shard->mutex);
+        }
+    }
+
+    // Return the solution, converting the IDs of the sorted tiles back to the
+    // IDs of the tiles given by the caller
+    if (solutionOperations) {
+        uint8_t* solutionOperation = problem.solutionOperations;
+        while (*solutionOperation) {
+            uint8_t operationEncoded = *solutionOperation++;
+            *solutionOperations++ = tileIds[operationEncoded & 7] | (tileIds[(operationEncoded >> 3) & 7] << 3) | (operationEncoded & (3 << 6));
+        }
+        *solutionOperations = 0;
+    }
+    if (complexity) {
+        *complexity = problem.complexity;
+    }
+    if (result) {
+        *result = problem.result;
+    }
+    return error;
+}
+
+// Check whether a candidate is better than another one to reach a target
+// (assuming their results are at the same distance from the target)
+inline static Bool IsBetterCandidate (Context* context, RangeCandidate* candidate, RangeCandidate* candidateReference) {
+    if (candidateReference->operationId == OPERATION_ID_NONE) {
+        return TRUE;
+    }
+    if (candidate->tileCount != candidateReference->tileCount) {
+        return candidate->tileCount < candidateReference->tileCount ? TRUE : FALSE;
+    }
+#ifndef DISABLE_COMPLEXITY
+    return context->operations.complexities[candidate->operationId] < context->operations.complexities[candidateReference->operationId] ? TRUE : FALSE;
+#else
+    return FALSE;
+#endif
+}
+
+// Solve the game for a range of targets
+extern NumbersError NumbersSolveRange (NumbersObject numbersObject, uint32_t targetFirst, uint32_t targetLast, NumbersTiles* tiles, uint16_t complexityMax, NumbersSolution* solutions) {
+
+    // Check the pointers
+    if (!numbersObject || !tiles || !solutions) {
+        return NullPointerError;
+    }
+
+    // Let the variant of the library that initialized the object deal with it
+    // (if it isn't this one)
+    if (numbersObject->variant != &variant) {
+        return numbersObject->variant->solveRange (numbersObject, targetFirst, targetLast, tiles, complexityMax, solutions);
+    }
+    if (tiles->count > 8) {
+        return TooManyTilesError;
+    }
+    if (targetFirst > targetLast) {
+        return ZeroSizeError;
+    }
+    uint32_t targetCount = targetLast - targetFirst + 1;
+    if (!targetCount) {
+        return TooLargeSizeError;
+    }
+
+    // Allocate the candidates (the best way to get each result of the range,
+    // then the closest result to each target)
+    RangeCandidate* candidates = malloc (sizeof (candidates[0]) * targetCount * 2);
+    if (!candidates) {
+        return MemoryAllocationError;
+    }
+    RangeCandidate* candidatesClosest = &candidates[targetCount];
+
+    // Record all possible operations
+    NumbersError error = Search (numbersObject, targetFirst, tiles, complexityMax, TRUE);
+    if (error != Success && error != AbortedError) {
+        free (candidates);
+        return error;
+    }
+
+    // Find the best way to get each result of the range, as well as the
+    // closest results below and above the range
+    Context* context = &numbersObject->context;
+    uint32_t* results = context->operations.results;
+    RangeCandidate candidateBelow = {OPERATION_ID_NONE, 0};
+    RangeCandidate candidateAbove = {OPERATION_ID_NONE, 0};
+    for (uint32_t targetId = 0; targetId < targetCount; ++targetId) {
+        candidates[targetId].operationId = OPERATION_ID_NONE;
+    }
+    uint32_t operationGroupSize = 1 << tiles->count;
+    for (uint32_t tileGroup = 1; tileGroup < operationGroupSize; ++tileGroup) {
+        OperationGroup* operationGroup = &numbersObject->operationGroups[tileGroup];
+        RangeCandidate candidate;
+        candidate.tileCount = __builtin_popcount (tileGroup);
+        for (candidate.operationId = operationGroup->operationIdFirst;
+            candidate.operationId < operationGroup->operationIdLast; ++candidate.operationId) {
+            uint32_t result = results[candidate.operationId];
+            if (result < targetFirst) {
+                if (candidateBelow.operationId == OPERATION_ID_NONE
+                    || result > results[candidateBelow.operationId]
+                    || (result == results[candidateBelow.operationId] && IsBetterCandidate (context, &candidate, &candidateBelow))) {
+                    candidateBelow = candidate;
+                }
+            } else if (result > targetLast) {
+                if (candidateAbove.operationId == OPERATION_ID_NONE
+                    || result < results[candidateAbove.operationId]
+                    || (result == results[candidateAbove.operationId] && IsBetterCandidate (context, &candidate, &candidateAbove))) {
+                    candidateAbove = candidate;
+                }
+            } else if (IsBetterCandidate (context, &candidate, &candidates[result - targetFirst])) {
+                candidates[result - targetFirst] = candidate;
+            }
+        }
+    }
+
+    // Find the closest result below each target, then compare it to the
+    // closest result above it (preferring the simplest way to reach the
+    // target when both are at the same distance, or the smallest result)
+    for (uint32_t targetId = 0; targetId < targetCount; ++targetId) {
+        if (candidates[targetId].operationId != OPERATION_ID_NONE) {
+            candidateBelow = candidates[targetId];
+        }
+        candidatesClosest[targetId] = candidateBelow;
+    }
+    for (uint32_t targetId = targetCount; targetId--;) {
+        if (candidates[targetId].operationId != OPERATION_ID_NONE) {
+            candidateAbove = candidates[targetId];
+        }
+        RangeCandidate* candidateClosest = &candidatesClosest[targetId];
+        if (candidateAbove.operationId != OPERATION_ID_NONE) {
+            uint32_t target = targetFirst + targetId;
+            if (candidateClosest->operationId == OPERATION_ID_NONE) {
+                *candidateClosest = candidateAbove;
+            } else {
+                uint32_t targetDiffBelow = target - results[candidateClosest->operationId];
+                uint32_t targetDiffAbove = results[candidateAbove.operationId] - target;
+                if (targetDiffAbove < targetDiffBelow
+                    || (targetDiffAbove == targetDiffBelow && IsBetterCandidate (context, &candidateAbove, candidateClosest))) {
+                    *candidateClosest = candidateAbove;
+                }
+            }
+        }
+
+        // Generate the solution
+        NumbersSolution* solution = &solutions[targetId];
+        if (candidateClosest->operationId == OPERATION_ID_NONE) {
+            solution->result = 0;
+            solution->complexity = 0;
+            solution->solutionOperations[0] = 0;
+        } else {
+            uint16_t solutionOperationsExtended[NUMBERS_TILE_COUNT_MAX];
+            uint16_t* solutionOperationExtended = solutionOperationsExtended;
+            uint32_t tileGroupUsed = 0;
+            GenerateSolution (context->operations.origins, numbersObject->duplicates.tileGroups,
+                candidateClosest->operationId, &solutionOperationExtended, &tileGroupUsed);
+            *solutionOperationExtended = 0;
+            ConvertSolution (solutionOperationsExtended, solution->solutionOperations);
+            solution->result = results[candidateClosest->operationId];
+#ifndef DISABLE_COMPLEXITY
+            solution->complexity = context->operations.complexities[candidateClosest->operationId];
+#else
+            solution->complexity = 0;
+#endif
+        }
+    }
+
+    // Done
+    free (candidates);
+    return error;
+}
+
+// Check whether a candidate is better than another one (closer to the target,
+// then simpler, then using fewer tiles)
+inline static Bool IsBetterTopCandidate (TopCandidate* candidate, TopCandidate* candidateReference) {
+    if (candidate->targetDiff != candidateReference->targetDiff) {
+        return candidate->targetDiff < candidateReference->targetDiff ? TRUE : FALSE;
+    }
+    if (candidate->complexity != candidateReference->complexity) {
+        return candidate->complexity < candidateReference->complexity ? TRUE : FALSE;
+    }
+    if (candidate->tileCount != candidateReference->tileCount) {
+        return candidate->tileCount < candidateReference->tileCount ? TRUE : FALSE;
+    }
+    return candidate->operationId < candidateReference->operationId ? TRUE : FALSE;
+}
+
+// Generate a solution from an operation recorded by the object
+static void GenerateSolutionEntry (NumbersObject numbersObject, TopCandidate* candidate, NumbersSolution* solution) {
+    Context* context = &numbersObject->context;
+    uint16_t solutionOperationsExtended[8];
+    uint16_t* solutionOperationExtended = solutionOperationsExtended;
+    uint32_t tileGroupUsed = 0;
+    GenerateSolution (context->operations.origins, numbersObject->duplicates.tileGroups,
+        candidate->operationId, &solutionOperationExtended, &tileGroupUsed);
+    *solutionOperationExtended = 0;
+    ConvertSolution (solutionOperationsExtended, solution->solutionOperations);
+    solution->result = context->operations.results[candidate->operationId];
+    solution->complexity = candidate->complexity;
+}
+
+// Check whether an operation, or one of the operations it comes from, gives
+// another result which is at least as close to the target
+static Bool IsIntermediateResultCloser (OperationOrigin* origins, uint32_t* results, OperationId operationId, uint32_t target, uint32_t result, uint32_t targetDiff) {
+    uint32_t resultIntermediate = results[operationId];
+    uint32_t targetDiffIntermediate = resultIntermediate > target ? resultIntermediate - target : target - resultIntermediate;
+    if (targetDiffIntermediate <= targetDiff && resultIntermediate != result) {
+        return TRUE;
+    }
+    OperationOrigin* origin = &origins[operationId];
+    if (origin->op == NOP) {
+        return FALSE;
+    }
+    return IsIntermediateResultCloser (origins, results, origin->operationIdLeft, target, result, targetDiff)
+        || IsIntermediateResultCloser (origins, results, origin->operationIdRight, target, result, targetDiff) ? TRUE : FALSE;
+}
+
+// Check whether the solution of a candidate actually reaches the result of the
+// candidate, i.e. whether no tile and no intermediate result is at least as
+// close to the target (NumbersValidate would otherwise report this other
+// result, the candidate being a worse version of another one)
+static Bool IsTopCandidateReached (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, TopCandidate* candidate) {
+    Context* context = &numbersObject->context;
+    uint32_t result = context->operations.results[candidate->operationId];
+    for (uint32_t tileId = 0; tileId < tiles->count; ++tileId) {
+        uint32_t tileValue = tiles->values[tileId];
+        uint32_t targetDiff = tileValue > target ? tileValue - target : target - tileValue;
+        if (targetDiff <= candidate->targetDiff && tileValue != result) {
+            return FALSE;
+        }
+    }
+    return IsIntermediateResultCloser (context->operations.origins, context->operations.results,
+        candidate->operationId, target, result, candidate->targetDiff) ? FALSE : TRUE;
+}
+
+// Move a candidate down a heap of candidates (the worst candidate being at the
+// root of the heap)
+static void TopCandidateHeapDown (TopCandidate* candidates, uint32_t candidateCount, uint32_t heapId, TopCandidate* candidate) {
+    uint32_t heapChildId;
+    while ((heapChildId = (heapId << 1) + 1) < candidateCount) {
+        if (heapChildId + 1 < candidateCount && IsBetterTopCandidate (&candidates[heapChildId], &candidates[heapChildId + 1])) {
+            ++heapChildId;
+        }
+        if (!IsBetterTopCandidate (candidate, &candidates[heapChildId])) {
+            break;
+        }
+        candidates[heapId] = candidates[heapChildId];
+        heapId = heapChildId;
+    }
+    candidates[heapId] = *candidate;
+}
+
+// Solve the game, getting several solutions
+extern NumbersError NumbersSolveTop (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t complexityMax, uint32_t solutionCountMax, NumbersSolution* solutions, uint32_t* solutionCount) {
+
+    // Check the pointers
+    if (!numbersObject || !tiles || !solutions || !solutionCount) {
+        return NullPointerError;
+    }
+
+    // Let the variant of the library that initialized the object deal with it
+    // (if it isn't this one)
+    if (numbersObject->variant != &variant) {
+        return numbersObject->variant->solveTop (numbersObject, target, tiles, complexityMax, solutionCountMax, solutions, solutionCount);
+    }
+    *solutionCount = 0;
+    if (tiles->count > 8) {
+        return TooManyTilesError;
+    }
+    if (!solutionCountMax) {
+        return ZeroSizeError;
+    }
+
+    // Allocate the candidates
+    TopCandidate* candidates = malloc (sizeof (candidates[0]) * solutionCountMax);
+    if (!candidates) {
+        return MemoryAllocationError;
+    }
+
+    // Record all possible operations
+    NumbersError error = Search (numbersObject, target, tiles, complexityMax, TRUE);
+    if (error != Success && error != AbortedError) {
+        free (candidates);
+        return error;
+    }
+
+    // Keep the best candidates in a heap (groups of tiles equivalent to other
+    // ones share their operations, hence are skipped)
+    Context* context = &numbersObject->context;
+    uint32_t candidateCount = 0;
+    uint32_t operationGroupSize = 1 << tiles->count;
+    for (uint32_t tileGroup = 1; tileGroup < operationGroupSize; ++tileGroup) {
+        if (!IsCanonicalTileGroup (numbersObject, tileGroup, operationGroupSize - 1)) {
+            continue;
+        }
+        OperationGroup* operationGroup = &numbersObject->operationGroups[tileGroup];
+        TopCandidate candidate;
+        candidate.tileCount = __builtin_popcount (tileGroup);
+        for (candidate.operationId = operationGroup->operationIdFirst;
+            candidate.operationId < operationGroup->operationIdLast; ++candidate.operationId) {
+            uint32_t result = context->operations.results[candidate.operationId];
+            candidate.targetDiff = result > target ? result - target : target - result;
+#ifndef DISABLE_COMPLEXITY
+            candidate.complexity = context->operations.complexities[candidate.operationId];
+#else
+            candidate.complexity = 0;
+#endif
+
+            // Skip the candidates which wouldn't be kept, or whose solution
+            // gets closer to the target before reaching their result
+            if (candidateCount == solutionCountMax && !IsBetterTopCandidate (&candidate, &candidates[0])) {
+                continue;
+            }
+            if (!IsTopCandidateReached (numbersObject, target, tiles, &candidate)) {
+                continue;
+            }
+            if (candidateCount < solutionCountMax) {
+
+                // Add the candidate to the heap
+                uint32_t heapId = candidateCount++;
+                while (heapId) {
+                    uint32_t heapParentId = (heapId - 1) >> 1;
+                    if (IsBetterTopCandidate (&candidate, &candidates[heapParentId])) {
+                        break;
+                    }
+                    candidates[heapId] = candidates[heapParentId];
+                    heapId = heapParentId;
+                }
+                candidates[heapId] = candidate;
+            } else {
+
+                // Replace the worst candidate
+                TopCandidateHeapDown (candidates, candidateCount, 0, &candidate);
+            }
+        }
+    }
+
+    // Generate the solutions, from the worst to the best
+    *solutionCount = candidateCount;
+    while (candidateCount) {
+        TopCandidate candidate = candidates[0];
+        --candidateCount;
+        TopCandidateHeapDown (candidates, candidateCount, 0, &candidates[candidateCount]);
+        GenerateSolutionEntry (numbersObject, &candidate, &solutions[candidateCount]);
+    }
+
+    // Done
+    free (candidates);
+    return error;
+}
+
+// Solve the game for all maximum complexities at once
+extern NumbersError NumbersSolvePareto (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint32_t solutionCountMax, NumbersSolution* solutions, uint32_t* solutionCount) {
+
+    // Check the pointers
+    if (!numbersObject || !tiles || !solutionCount || (solutionCountMax && !solutions)) {
+        return NullPointerError;
+    }
+
+    // Let the variant of the library that initialized the object deal with it
+    // (if it isn't this one)
+    if (numbersObject->variant != &variant) {
+        return numbersObject->variant->solvePareto (numbersObject, target, tiles, solutionCountMax, solutions, solutionCount);
+    }
+    *solutionCount = 0;
+    if (tiles->count > 8) {
+        return TooManyTilesError;
+    }
+
+    // Allocate the frontier (there can't be more than 1 candidate per
+    // complexity, but it is usually a lot smaller)
+    uint32_t candidateSize = 64;
+    TopCandidate* candidates = malloc (sizeof (candidates[0]) * candidateSize);
+    if (!candidates) {
+        return MemoryAllocationError;
+    }
+
+    // Record all possible operations
+    NumbersError error = Search (numbersObject, target, tiles, UINT16_MAX, TRUE);
+    if (error != Success && error != AbortedError) {
+        free (candidates);
+        return error;
+    }
+
+    // Build the frontier: its candidates are sorted by complexity, each of
+    // them being closer to the target than all the simpler ones (groups of
+    // tiles equivalent to other ones share their operations, hence are
+    // skipped)
+    Context* context = &numbersObject->context;
+    uint32_t candidateCount = 0;
+    uint32_t operationGroupSize = 1 << tiles->count;
+    for (uint32_t tileGroup = 1; tileGroup < operationGroupSize; ++tileGroup) {
+        if (!IsCanonicalTileGroup (numbersObject, tileGroup, operationGroupSize - 1)) {
+            continue;
+        }
+        OperationGroup* operationGroup = &numbersObject->operationGroups[tileGroup];
+        TopCandidate candidate;
+        candidate.tileCount = __builtin_popcount (tileGroup);
+        for (candidate.operationId = operationGroup->operationIdFirst;
+            candidate.operationId < operationGroup->operationIdLast; ++candidate.operationId) {
+            uint32_t result = context->operations.results[candidate.operationId];
+            candidate.targetDiff = result > target ? result - target : target - result;
+#ifndef DISABLE_COMPLEXITY
+            candidate.complexity = context->operations.complexities[candidate.operationId];
+#else
+            candidate.complexity = 0;
+#endif
+
+            // Find the last candidate of the frontier which isn't more complex
+            uint32_t candidateIdFirst = 0;
+            uint32_t candidateIdLast = candidateCount;
+            while (candidateIdFirst < candidateIdLast) {
+                uint32_t candidateId = (candidateIdFirst + candidateIdLast) >> 1;
+                if (candidates[candidateId].complexity <= candidate.complexity) {
+                    candidateIdFirst = candidateId + 1;
+                } else {
+                    candidateIdLast = candidateId;
+                }
+            }
+
+            // Make sure it doesn't dominate the new candidate
+            uint32_t candidateId = candidateIdFirst;
+            if (candidateId) {
+                TopCandidate* candidateSimpler = &candidates[candidateId - 1];
+                if (candidateSimpler->targetDiff <= candidate.targetDiff
+                    && IsBetterTopCandidate (candidateSimpler, &candidate)) {
+                    continue;
+                }
+                if (candidateSimpler->complexity == candidate.complexity) {
+                    --candidateId;
+                }
+            }
+
+            // Remove the candidates dominated by the new one
+            candidateIdLast = candidateId;
+            while (candidateIdLast < candidateCount && candidates[candidateIdLast].targetDiff >= candidate.targetDiff) {
+                ++candidateIdLast;
+            }
+            if (candidateIdLast == candidateId && candidateCount == candidateSize) {
+                candidateSize <<= 1;
+                TopCandidate* candidatesGrown = realloc (candidates, sizeof (candidates[0]) * candidateSize);
+                if (!candidatesGrown) {
+                    free (candidates);
+                    return MemoryAllocationError;
+                }
+                candidates = candidatesGrown;
+            }
+            memmove (&candidates[candidateId + 1], &candidates[candidateIdLast], sizeof (candidates[0]) * (candidateCount - candidateIdLast));
+            candidateCount += candidateId + 1 - candidateIdLast;
+
+            // Insert the new candidate
+            candidates[candidateId] = candidate;
+        }
+    }
+
+    // Generate the solutions (as long as they fit)
+    *solutionCount = candidateCount;
+    if (candidateCount > solutionCountMax) {
+        error = TooLargeSizeError;
+        candidateCount = solutionCountMax;
+    }
+    for (uint32_t candidateId = 0; candidateId < candidateCount; ++candidateId) {
+        GenerateSolutionEntry (numbersObject, &candidates[candidateId], &solutions[candidateId]);
+    }
+
+    // Done
+    free (candidates);
+    return error;
+}
+
+// Pick the solution of the frontier for a maximum complexity
+extern NumbersError NumbersSelectPareto (uint32_t solutionCount, NumbersSolution* solutions, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result) {
+
+    // Check the pointer
+    if (solutionCount && !solutions) {
+        return NullPointerError;
+    }
+
+    // Find the last solution which doesn't exceed the maximum complexity
+    uint16_t complexityMax = complexity ? *complexity : UINT16_MAX;
+    uint32_t solutionIdFirst = 0;
+    uint32_t solutionIdLast = solutionCount;
+    while (solutionIdFirst < solutionIdLast) {
+        uint32_t solutionId = (solutionIdFirst + solutionIdLast) >> 1;
+        if (solutions[solutionId].complexity <= complexityMax) {
+            solutionIdFirst = solutionId + 1;
+        } else {
+            solutionIdLast = solutionId;
+        }
+    }
+
+    // Copy the solution
+    if (!solutionIdFirst) {
+        if (solutionOperations) {
+            *solutionOperations = 0;
+        }
+        if (complexity) {
+            *complexity = 0;
+        }
+        if (result) {
+            *result = 0;
+        }
+    } else {
+        NumbersSolution* solution = &solutions[solutionIdFirst - 1];
+        if (solutionOperations) {
+            uint32_t operationId = 0;
+            do {
+                solutionOperations[operationId] = solution->solutionOperations[operationId];
+            } while (solution->solutionOperations[operationId++]);
+        }
+        if (complexity) {
+            *complexity = solution->complexity;
+        }
+        if (result) {
+            *result = solution->result;
+        }
+    }
+    return Success;
+}
+
+// Initialize a snapshot
+extern NumbersError NumbersSnapshotInitialize (NumbersObject numbersObject, NumbersTiles* tiles, NumbersSnapshotObject* snapshotObject_) {
+
+    // Check the pointers
+    if (!snapshotObject_) {
+        return NullPointerError;
+    }
+    *snapshotObject_ = NULL;
+    if (!numbersObject || !tiles) {
+        return NullPointerError;
+    }
+
+    // Let the variant of the library that initialized the object deal with it
+    // (if it isn't this one)
+    if (numbersObject->variant != &variant) {
+        return numbersObject->variant->snapshotInitialize (numbersObject, tiles, snapshotObject_);
+    }
+    if (tiles->count > 8) {
+        return TooManyTilesError;
+    }
+
+    // Record all possible operations
+    NumbersError error = Search (numbersObject, 0, tiles, UINT16_MAX, TRUE);
+    if (error != Success && error != AbortedError) {
+        return error;
+    }
+
+    // Count the operations (groups of tiles equivalent to other ones share
+    // their operations)
+    Context* context = &numbersObject->context;
+    uint32_t operationGroupSize = 1 << tiles->count;
+    uint32_t operationCount = 0;
+    for (uint32_t tileGroup = 1; tileGroup < operationGroupSize; ++tileGroup) {
+        if (IsCanonicalTileGroup (numbersObject, tileGroup, operationGroupSize - 1)) {
+            OperationGroup* operationGroup = &numbersObject->operationGroups[tileGroup];
+            operationCount += operationGroup->operationIdLast - operationGroup->operationIdFirst;
+        }
+    }
+
+    // Allocate an object
+    NumbersSnapshotObject snapshotObject = malloc (sizeof (struct NumbersSnapshotStruct));
+    if (!snapshotObject) {
+        return MemoryAllocationError;
+    }
+    uint32_t originCount = context->current.operationIdLast;
+    snapshotObject->origins = malloc (sizeof (snapshotObject->origins[0]) * (originCount ? originCount : 1));
+    snapshotObject->operations = malloc (sizeof (snapshotObject->operations[0]) * (operationCount ? operationCount : 1));
+    uint64_t* sortedOperations = malloc (sizeof (sortedOperations[0]) * (operationCount ? operationCount : 1) * 3);
+    if (!snapshotObject->origins || !snapshotObject->operations || !sortedOperations) {
+        free (snapshotObject->origins);
+        free (snapshotObject->operations);
+        free (sortedOperations);
+        free (snapshotObject);
+        return MemoryAllocationError;
+    }
+
+    // Copy the origins of all operations (to generate the solutions) and the
+    // groups of equal tiles
+    memcpy (snapshotObject->origins, context->operations.origins, sizeof (snapshotObject->origins[0]) * originCount);
+    memcpy (snapshotObject->duplicateTileGroups, numbersObject->duplicates.tileGroups, sizeof (snapshotObject->duplicateTileGroups[0]) * tiles->count);
+
+    // Sort the operations by number of tiles and complexity (each of them
+    // being stored as its number of tiles in bits 48-63, its complexity in
+    // bits 32-47 and its ID in the lower 32 bits)
+    uint64_t* sortedOperationsByComplexity = &sortedOperations[operationCount];
+    uint64_t* sortedOperationsBuffer = &sortedOperations[operationCount * 2];
+    uint32_t operationIndex = 0;
+    for (uint32_t tileGroup = 1; tileGroup < operationGroupSize; ++tileGroup) {
+        if (IsCanonicalTileGroup (numbersObject, tileGroup, operationGroupSize - 1)) {
+            OperationGroup* operationGroup = &numbersObject->operationGroups[tileGroup];
+            uint64_t tileCount = __builtin_popcount (tileGroup);
+            for (OperationId operationId = operationGroup->operationIdFirst; operationId < operationGroup->operationIdLast; ++operationId) {
+#ifndef DISABLE_COMPLEXITY
+                uint64_t complexity = context->operations.complexities[operationId];
+#else
+                uint64_t complexity = 0;
+#endif
+                sortedOperationsByComplexity[operationIndex++] = (tileCount << 48) | (complexity << 32) | operationId;
+            }
+        }
+    }
+    SortOperations (sortedOperationsByComplexity, sortedOperationsBuffer, operationCount);
+
+    // Then sort them by result (the sort being stable, operations with the
+    // same result remain sorted by number of tiles and complexity; each of
+    // them is stored as its result in the upper 32 bits and its position in
+    // the previous array in the lower 32 bits)
+    for (operationIndex = 0; operationIndex < operationCount; ++operationIndex) {
+        OperationId operationId = (uint32_t)sortedOperationsByComplexity[operationIndex];
+        sortedOperations[operationIndex] = ((uint64_t)context->operations.results[operationId] << 32) | operationIndex;
+    }
+    SortOperations (sortedOperations, sortedOperationsBuffer, operationCount);
+    for (operationIndex = 0; operationIndex < operationCount; ++operationIndex) {
+        uint64_t sortedOperation = sortedOperationsByComplexity[(uint32_t)sortedOperations[operationIndex]];
+        SnapshotOperation* operation = &snapshotObject->operations[operationIndex];
+        operation->result = sortedOperations[operationIndex] >> 32;
+        operation->complexity = sortedOperation >> 32;
+        operation->tileCount = sortedOperation >> 48;
+        operation->operationId = (uint32_t)sortedOperation;
+    }
+    snapshotObject->operationCount = operationCount;
+    free (sortedOperations);
+
+    // Return the object
+    *snapshotObject_ = snapshotObject;
+
+    // Done
+    return error;
+}
+
+// Shut down a snapshot
+extern NumbersError NumbersSnapshotShutdown (NumbersSnapshotObject snapshotObject) {
+
+    // Check the pointer
+    if (!snapshotObject) {
+        return NullPointerError;
+    }
+
+    // Destroy the object
+    free (snapshotObject->origins);
+    free (snapshotObject->operations);
+    free (snapshotObject);
+
+    // Done
+    return Success;
+}
+
+// Solve the game, using a snapshot
+extern NumbersError NumbersSolveSnapshot (NumbersSnapshotObject snapshotObject, uint32_t target, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result) {
+
+    // Check the pointer
+    if (!snapshotObject) {
+        return NullPointerError;
+    }
+
+    // Search for the first operation which result isn't below the target
+    SnapshotOperation* operations = snapshotObject->operations;
+    uint32_t positionFirst = 0;
+    uint32_t positionLast = snapshotObject->operationCount;
+    while (positionFirst < positionLast) {
+        uint32_t position = (positionFirst + positionLast) >> 1;
+        if (operations[position].result < target) {
+            positionFirst = position + 1;
+        } else {
+            positionLast = position;
+        }
+    }
+
+    // Find the closest result above the target (or equal to it) which doesn't
+    // exceed the maximum complexity
+    uint16_t complexityMax = complexity ? *complexity : UINT16_MAX;
+    SnapshotOperation* operationAbove = NULL;
+    for (uint32_t position = positionFirst; position < snapshotObject->operationCount; ++position) {
+        if (operations[position].complexity <= complexityMax) {
+            operationAbove = &operations[position];
+            break;
+        }
+    }
+
+    // Find the closest result below the target (the best way to get it being
+    // the first one of its operations that doesn't exceed the maximum
+    // complexity)
+    SnapshotOperation* operationBelow = NULL;
+    for (uint32_t position = positionFirst; position--;) {
+        if (operationAbove && target - operations[position].result > operationAbove->result - target) {
+            break;
+        }
+        if (operations[position].complexity <= complexityMax) {
+            operationBelow = &operations[position];
+            while (position-- && operations[position].result == operationBelow->result) {
+                if (operations[position].complexity <= complexityMax) {
+                    operationBelow = &operations[position];
+                }
+            }
+            break;
+        }
+    }
+
+    // Pick the closest result (preferring the simplest way to reach the
+    // target when both are at the same distance, or the smallest result)
+    SnapshotOperation* operation = operationBelow;
+    if (operationAbove) {
+        if (!operationBelow
+            || operationAbove->result - target < target - operationBelow->result
+            || (operationAbove->result - target == target - operationBelow->result
+                && (operationAbove->tileCount < operationBelow->tileCount
+                    || (operationAbove->tileCount == operationBelow->tileCount
+                        && operationAbove->complexity < operationBelow->complexity)))) {
+            operation = operationAbove;
+        }
+    }
+
+    // Generate the solution
+    if (!operation) {
+        if (solutionOperations) {
+            *solutionOperations = 0;
+        }
+        if (complexity) {
+            *complexity = 0;
+        }
+        if (result) {
+            *result = 0;
+        }
+    } else {
+        if (solutionOperations) {
+            uint16_t solutionOperationsExtended[8];
+            uint16_t* solutionOperationExtended = solutionOperationsExtended;
+            uint32_t tileGroupUsed = 0;
+            GenerateSolution (snapshotObject->origins, snapshotObject->duplicateTileGroups,
+                operation->operationId, &solutionOperationExtended, &tileGroupUsed);
+            *solutionOperationExtended = 0;
+            ConvertSolution (solutionOperationsExtended, solutionOperations);
+        }
+        if (complexity) {
+            *complexity = operation->complexity;
+        }
+        if (result) {
+            *result = operation->result;
+        }
     }
+    return Success;
+}
 
-    // Record or update the operation
-    Operation* operation = &numbersObject->operations[operationId];
-    if (operationId == numbersObject->current.operationIdLast) {
-
-        // Make sure the operation can be recorded
-        if (operationId >= numbersObject->operationSize) {
-
-            // The array is full, let's return the best solution found so
-            // far...
-            numbersObject->solution.aborted = TRUE;
-            return;
+// Solve the problems of a batch until there are none left
+static void BatchThreadSolveProblems (BatchThread* batchThread) {
+
+    // Go through the ranges of problems of all threads, starting with the
+    // range of this thread
+    NumbersBatchObject batchObject = batchThread->batchObject;
+    uint32_t threadId = batchThread - batchObject->threads;
+    for (uint32_t threadCount = 0; threadCount < batchObject->threadCount; ++threadCount) {
+        BatchThread* batchThreadVictim = &batchObject->threads[(threadId + threadCount) % batchObject->threadCount];
+
+        // Take a few problems at once, until the range is empty
+        uint32_t problemIdFirst;
+        while ((problemIdFirst = atomic_fetch_add (&batchThreadVictim->problemIdNext, BATCH_PROBLEM_GRAIN)) < batchThreadVictim->problemIdLast) {
+            uint32_t problemIdLast = batchThreadVictim->problemIdLast - problemIdFirst > BATCH_PROBLEM_GRAIN ?
+                problemIdFirst + BATCH_PROBLEM_GRAIN : batchThreadVictim->problemIdLast;
+            for (uint32_t problemId = problemIdFirst; problemId < problemIdLast; ++problemId) {
+
+                // Solve the problem
+                NumbersProblem* problem = &batchObject->problems[problemId];
+                NumbersSolution* solution = &batchObject->solutions[problemId];
+                solution->complexity = problem->complexity;
+                NumbersError error = NumbersSolve (batchThread->numbersObject, problem->target, &problem->tiles,
+                    &solution->complexity, solution->solutionOperations, &solution->result);
+                if (error != Success && error != AbortedError) {
+                    solution->result = 0;
+                    solution->complexity = 0;
+                    solution->solutionOperations[0] = 0;
+                }
+                batchObject->errors[problemId] = error;
+            }
         }
+    }
+}
 
-        // If possible, record the ID of this operation, to allow searching for
-        // its result
-        if (result < numbersObject->operationIdSize) {
-            numbersObject->operationIds[result] = operationId;
+// Batch thread start routine
+static void* BatchThreadRun (void* data) {
+
+    // Wait for some work, until the object gets shut down
+    BatchThread* batchThread = (BatchThread*)data;
+    NumbersBatchObject batchObject = batchThread->batchObject;
+    uint32_t generation = 0;
+    pthread_mutex_lock (&batchObject->mutex);
+    while (1) {
+        while (batchObject->generation == generation && !batchObject->shutdown) {
+            pthread_cond_wait (&batchObject->start, &batchObject->mutex);
         }
+        if (batchObject->shutdown) {
+            break;
+        }
+        generation = batchObject->generation;
+        pthread_mutex_unlock (&batchObject->mutex);
 
-        // Record the operation
-        operation->result = result;
-        ++numbersObject->current.operationIdLast;
+        // Work!
+        BatchThreadSolveProblems (batchThread);
 
-        // Take note of the best solution so far
-        if (bestResult) {
-            numbersObject->solution.operationId = operationId;
-            numbersObject->solution.targetDiff = targetDiff;
-            numbersObject->solution.tileCount = numbersObject->current.tileCount;
+        // Inform the thread calling NumbersSolveBatch
+        pthread_mutex_lock (&batchObject->mutex);
+        if (--batchObject->busyCount == 0) {
+            pthread_cond_signal (&batchObject->done);
         }
-
-#ifndef DISABLE_COMPLEXITY
-        // Take note of the "weight" of this result, to allow computing the
-        // complexity of operations
-        operation->weight = ComputeResultWeight (result);
-#endif
     }
-    operation->operationIdLeft = numbersObject->current.operationIdLeft;
-    operation->operationIdRight = numbersObject->current.operationIdRight;
-    operation->op = op;
-#ifndef DISABLE_COMPLEXITY
-    operation->complexity = complexity;
-#endif
+    pthread_mutex_unlock (&batchObject->mutex);
+    return NULL;
 }
 
-// Combine 2 groups of operations, computing all possible combinations of their
-// results
-static void CombineOperationGroups (NumbersObject numbersObject, OperationGroup* operationGroupA, OperationGroup* operationGroupB) {
-
-    // Go through all results of the group A
-    for (uint16_t operationIdA = operationGroupA->operationIdFirst;
-        operationIdA < operationGroupA->operationIdLast; ++operationIdA) {
+// Shut down a batch object
+extern NumbersError NumbersBatchShutdown (NumbersBatchObject batchObject) {
 
-        // Get information about this result
-        Operation* operationA = &numbersObject->operations[operationIdA];
-        uint32_t resultA = operationA->result;
-#ifndef DISABLE_COMPLEXITY
-        uint8_t weightA = operationA->weight;
-        uint16_t complexityA = operationA->complexity;
-#endif
+    // Check the pointer
+    if (!batchObject) {
+        return NullPointerError;
+    }
 
-        // Go through all results of the group B
-        for (uint16_t operationIdB = operationGroupB->operationIdFirst;
-            operationIdB < operationGroupB->operationIdLast; ++operationIdB) {
+    // Stop the threads
+    pthread_mutex_lock (&batchObject->mutex);
+    batchObject->shutdown = TRUE;
+    pthread_cond_broadcast (&batchObject->start);
+    pthread_mutex_unlock (&batchObject->mutex);
+    for (uint32_t threadId = 1; threadId < batchObject->threadCount; ++threadId) {
+        pthread_join (batchObject->threads[threadId].thread, NULL);
+    }
 
-            // Compute the overall complexity to get that far
-            Operation* operationB = &numbersObject->operations[operationIdB];
-#ifndef DISABLE_COMPLEXITY
-            uint16_t complexityAB = complexityA + operationB->complexity;
-            if (complexityAB > numbersObject->current.complexityMax) {
-                continue;
-            }
-#endif
+    // Destroy the object
+    for (uint32_t threadId = 0; threadId < batchObject->threadCount; ++threadId) {
+        NumbersShutdown (batchObject->threads[threadId].numbersObject);
+    }
+    free (batchObject->threads);
+    pthread_cond_destroy (&batchObject->done);
+    pthread_cond_destroy (&batchObject->start);
+    pthread_mutex_destroy (&batchObject->mutex);
+    free (batchObject);
 
-            // Get information about this result
-            uint32_t resultB = operationB->result;
-#ifndef DISABLE_COMPLEXITY
-            uint8_t weightB = operationB->weight;
-#endif
+    // Done
+    return Success;
+}
 
-            // Order the results
-            uint32_t resultMax;
-            uint32_t resultMin;
-            if (resultA >= resultB) {
-                resultMax = resultA;
-                resultMin = resultB;
-                numbersObject->current.operationIdLeft = operationIdA;
-                numbersObject->current.operationIdRight = operationIdB;
-            } else {
-                resultMax = resultB;
-                resultMin = resultA;
-                numbersObject->current.operationIdLeft = operationIdB;
-                numbersObject->current.operationIdRight = operationIdA;
-            }
+// Initialize a batch object
+extern NumbersError NumbersBatchInitialize (NumbersOptions* options, uint32_t threadCount, NumbersBatchObject* batchObject_) {
 
-            // Addition
-#ifndef DISABLE_COMPLEXITY
-            uint16_t complexity = complexityAB + (weightA < weightB ? weightA : weightB);
-#else
-            uint16_t complexity = 0;
-#endif
-            RecordOperation (numbersObject, ADD, resultMax + resultMin, complexity);
+    // Check the pointers
+    if (!batchObject_) {
+        return NullPointerError;
+    }
+    *batchObject_ = NULL;
+    if (!options) {
+        return NullPointerError;
+    }
 
-            // Subtraction
-            if (resultMax != resultMin) {
-                uint32_t result = resultMax - resultMin;
-                if (result != resultMin) {
-#ifndef DISABLE_COMPLEXITY
-                    complexity = complexityAB + ((weightA + weightB) >> 1);
-#endif
-                    RecordOperation (numbersObject, SUB, result, complexity);
-                }
-            }
+    // Check the number of threads
+    if (!threadCount) {
+        return ZeroSizeError;
+    }
 
-            // Make sure the smallest number is greater than 1
-            if (resultMin > 1) {
+    // Allocate an object
+    NumbersBatchObject batchObject = malloc (sizeof (struct NumbersBatchStruct));
+    if (!batchObject) {
+        return MemoryAllocationError;
+    }
+    batchObject->threads = malloc (sizeof (batchObject->threads[0]) * threadCount);
+    if (!batchObject->threads) {
+        free (batchObject);
+        return MemoryAllocationError;
+    }
 
-                // Multiplication
-                uint32_t result = resultMax * resultMin;
-#ifndef DISABLE_COMPLEXITY
-                complexity = weightA * weightB;
-                complexity = complexityAB + complexity * complexity;
-#endif
-                RecordOperation (numbersObject, MUL, result, complexity);
+    // Initialize the synchronization primitives
+    batchObject->threadCount = 0;
+    batchObject->generation = 0;
+    batchObject->busyCount = 0;
+    batchObject->shutdown = FALSE;
+    if (pthread_mutex_init (&batchObject->mutex, NULL)) {
+        free (batchObject->threads);
+        free (batchObject);
+        return ThreadError;
+    }
+    if (pthread_cond_init (&batchObject->start, NULL)) {
+        pthread_mutex_destroy (&batchObject->mutex);
+        free (batchObject->threads);
+        free (batchObject);
+        return ThreadError;
+    }
+    if (pthread_cond_init (&batchObject->done, NULL)) {
+        pthread_cond_destroy (&batchObject->start);
+        pthread_mutex_destroy (&batchObject->mutex);
+        free (batchObject->threads);
+        free (batchObject);
+        return ThreadError;
+    }
 
-                // Division
-                if (resultMax == resultMin) {
-#ifndef DISABLE_COMPLEXITY
-                    complexity = complexityAB + 1;
-#endif
-                    RecordOperation (numbersObject, DIV, 1, complexity);
-                } else {
-                    result = resultMax / resultMin;
-                    if (result != resultMin && result * resultMin == resultMax) {
-
-                        // Note: when such a division is actually possible
-                        // (which is not so frequent), it is probably not much
-                        // harder to find than to perform the multiplication,
-                        // hence the use of the same "complexity" value here
-                        RecordOperation (numbersObject, DIV, result, complexity);
-                    }
-                }
-            }
+    // Initialize each thread (the first thread is the one calling
+    // NumbersSolveBatch)
+    for (uint32_t threadId = 0; threadId < threadCount; ++threadId) {
+        BatchThread* batchThread = &batchObject->threads[threadId];
+        batchThread->batchObject = batchObject;
+        atomic_init (&batchThread->problemIdNext, 0);
+        batchThread->problemIdLast = 0;
+        NumbersError error = NumbersInitializeWithOptions (options, &batchThread->numbersObject);
+        if (error != Success) {
+            NumbersBatchShutdown (batchObject);
+            return error;
+        }
+        ++batchObject->threadCount;
+        if (threadId && pthread_create (&batchThread->thread, NULL, BatchThreadRun, (void*)batchThread)) {
+            NumbersShutdown (batchThread->numbersObject);
+            --batchObject->threadCount;
+            NumbersBatchShutdown (batchObject);
+            return ThreadError;
         }
     }
+
+    // Return the object
+    *batchObject_ = batchObject;
+
+    // Done
+    return Success;
 }
 
-// Generate the solution
-static uint16_t GenerateSolution (NumbersObject numbersObject, uint16_t operationId) {
+// Solve a batch of problems
+extern NumbersError NumbersSolveBatch (NumbersBatchObject batchObject, uint32_t problemCount, NumbersProblem* problems, NumbersError* errors, NumbersSolution* solutions) {
 
-    // Make sure there is an operation
-    Operation* operation = &numbersObject->operations[operationId];
-    if (operation->op == NOP) {
-        return operationId;
+    // Check the pointers
+    if (!batchObject || !problems || !errors || !solutions) {
+        return NullPointerError;
     }
 
-    // Track back...
-    uint16_t tileIdLeft = GenerateSolution (numbersObject, operation->operationIdLeft);
-    uint16_t tileIdRight = GenerateSolution (numbersObject, operation->operationIdRight);
+    // Split the problems evenly between the threads
+    batchObject->problems = problems;
+    batchObject->errors = errors;
+    batchObject->solutions = solutions;
+    for (uint32_t threadId = 0; threadId < batchObject->threadCount; ++threadId) {
+        BatchThread* batchThread = &batchObject->threads[threadId];
+        atomic_store (&batchThread->problemIdNext, (uint64_t)problemCount * threadId / batchObject->threadCount);
+        batchThread->problemIdLast = (uint64_t)problemCount * (threadId + 1) / batchObject->threadCount;
+    }
 
-    // Append the operation to the solution
-    *numbersObject->solution.operations = tileIdLeft | (tileIdRight << 3) | (operation->op << 6);
-    ++numbersObject->solution.operations;
+    // Wake up the other threads
+    pthread_mutex_lock (&batchObject->mutex);
+    batchObject->busyCount = batchObject->threadCount - 1;
+    ++batchObject->generation;
+    pthread_cond_broadcast (&batchObject->start);
+    pthread_mutex_unlock (&batchObject->mutex);
+
+    // Work, then wait for all threads to complete
+    BatchThreadSolveProblems (&batchObject->threads[0]);
+    pthread_mutex_lock (&batchObject->mutex);
+    while (batchObject->busyCount) {
+        pthread_cond_wait (&batchObject->done, &batchObject->mutex);
+    }
+    pthread_mutex_unlock (&batchObject->mutex);
 
-    // Assume the result will be stored in the left tile
-    return tileIdLeft;
+    // Done
+    return Success;
 }
 
-// Solve the game
-extern NumbersError NumbersSolve (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result) {
+// Shut down a pool
+extern NumbersError NumbersPoolShutdown (NumbersPoolObject poolObject) {
 
-    // Check the pointers
-    if (!numbersObject || !tiles) {
+    // Check the pointer
+    if (!poolObject) {
         return NullPointerError;
     }
-    if (tiles->count > 8) {
-        return TooManyTilesError;
-    }
 
-    // Take note of the target and number of tiles
-    numbersObject->final.target = target;
-    numbersObject->final.tileCount = tiles->count;
-
-    // Initialize the solution
-    numbersObject->solution.operationId = numbersObject->operationSize;
-    numbersObject->solution.aborted = FALSE;
-
-    // Create an array to record groups of operations (1 group per combination
-    // of tiles)
-    uint16_t operationGroupSize = 1 << numbersObject->final.tileCount;
-    OperationGroup operationGroups[operationGroupSize];
+    // Destroy the object
+    for (uint32_t slotId = 0; slotId < poolObject->slotCount; ++slotId) {
+        NumbersShutdown (poolObject->slots[slotId].numbersObject);
+    }
+    free (poolObject->slots);
+    free (poolObject);
 
-    // Record all the tiles
-    numbersObject->current.tileCount = 1;
-#ifndef DISABLE_COMPLEXITY
-    numbersObject->current.complexityMax = complexity ? *complexity : UINT16_MAX;
-#endif
-    numbersObject->current.operationIdLast = 0;
-    for (uint32_t tileId = 0; tileId < numbersObject->final.tileCount; ++tileId) {
+    // Done
+    return Success;
+}
 
-        // Record the tile
-        numbersObject->current.operationIdFirst = numbersObject->current.operationIdLast;
-        RecordOperation (numbersObject, NOP, tiles->values[tileId], 0);
+// Initialize a pool
+extern NumbersError NumbersPoolInitialize (NumbersOptions* options, uint32_t objectCount, NumbersPoolObject* poolObject_) {
 
-        // This tile alone defines a new operation group
-        uint32_t tileGroup = 1 << tileId;
-        operationGroups[tileGroup].operationIdFirst = numbersObject->current.operationIdFirst;
-        operationGroups[tileGroup].operationIdLast = numbersObject->current.operationIdLast;
+    // Check the pointers
+    if (!poolObject_) {
+        return NullPointerError;
+    }
+    *poolObject_ = NULL;
+    if (!options) {
+        return NullPointerError;
     }
 
-    // Perform all possible tile combinations, starting with just 2 tiles then
-    // adding some more
-    while (numbersObject->current.tileCount < numbersObject->final.tileCount
-        && numbersObject->solution.targetDiff != 0
-        && !numbersObject->solution.aborted) {
+    // Check the number of objects
+    if (!objectCount) {
+        return ZeroSizeError;
+    }
 
-        // Increase the number of tiles to include in the combination
-        ++numbersObject->current.tileCount;
+    // Allocate an object
+    NumbersPoolObject poolObject = malloc (sizeof (struct NumbersPoolStruct));
+    if (!poolObject) {
+        return MemoryAllocationError;
+    }
+    poolObject->slots = aligned_alloc (POOL_SLOT_SIZE, sizeof (poolObject->slots[0]) * objectCount);
+    if (!poolObject->slots) {
+        free (poolObject);
+        return MemoryAllocationError;
+    }
 
-        // Define a group with the number of tiles specified
-        uint32_t tileGroup = (1 << numbersObject->current.tileCount) - 1;
-        do {
+    // Initialize the Numbers library object of each slot
+    poolObject->slotCount = 0;
+    for (uint32_t slotId = 0; slotId < objectCount; ++slotId) {
+        PoolSlot* slot = &poolObject->slots[slotId];
+        atomic_init (&slot->acquired, FALSE);
+        NumbersError error = NumbersInitializeWithOptions (options, &slot->numbersObject);
+        if (error != Success) {
+            NumbersPoolShutdown (poolObject);
+            return error;
+        }
+        ++poolObject->slotCount;
+    }
 
-            // Break this group of tiles into 2 smaller groups (all possible
-            // combinations)
-            uint32_t tileSubGroupCount = (1 << (numbersObject->current.tileCount - 1)) - 1;
-            uint32_t tileSubGroups[tileSubGroupCount];
-            uint32_t tilesRemaining = tileGroup;
-            for (uint32_t tileSubGroupId = 0; tileSubGroupId < tileSubGroupCount; ++tileSubGroupId) {
-                tileSubGroups[tileSubGroupId] = 0;
-            }
-            for (uint32_t tileSubGroupMask = 1; tileSubGroupMask <= tileSubGroupCount; tileSubGroupMask <<= 1) {
-                uint32_t tile = tilesRemaining & -tilesRemaining;
-                for (uint32_t tileSubGroupNumber = 1; tileSubGroupNumber <= tileSubGroupCount; ++tileSubGroupNumber) {
-                    if ((tileSubGroupNumber & tileSubGroupMask) != 0) {
-                        tileSubGroups[tileSubGroupNumber - 1] += tile;
-                    }
-                }
-                tilesRemaining -= tile;
-            }
+    // Return the object
+    *poolObject_ = poolObject;
 
-            // Combine all pairs of smaller groups
-            numbersObject->current.operationIdFirst = numbersObject->current.operationIdLast;
-            for (uint32_t tileSubGroupId = 0; tileSubGroupId < tileSubGroupCount && !numbersObject->solution.aborted; ++tileSubGroupId) {
-                uint32_t tileSubGroup = tileSubGroups[tileSubGroupId];
-                CombineOperationGroups (numbersObject, &operationGroups[tileSubGroup], &operationGroups[tileGroup - tileSubGroup]);
-            }
+    // Done
+    return Success;
+}
 
-            // Record this new operation group
-            operationGroups[tileGroup].operationIdFirst = numbersObject->current.operationIdFirst;
-            operationGroups[tileGroup].operationIdLast = numbersObject->current.operationIdLast;
+// Acquire a Numbers library object from a pool
+extern NumbersError NumbersPoolAcquire (NumbersPoolObject poolObject, NumbersObject* numbersObject) {
 
-            // Next group of tiles (with the same number of tiles)
-            uint32_t u = tileGroup & -tileGroup;
-            uint32_t v = u + tileGroup;
-            tileGroup = v + (((v ^ tileGroup) / u) >> 2);
-        } while (tileGroup < operationGroupSize && !numbersObject->solution.aborted);
+    // Check the pointers
+    if (!numbersObject) {
+        return NullPointerError;
+    }
+    *numbersObject = NULL;
+    if (!poolObject) {
+        return NullPointerError;
     }
 
-    // Make sure a solution has been found
-    if (numbersObject->solution.operationId >= numbersObject->operationSize) {
-        if (solutionOperations) {
-            *solutionOperations = 0;
-        }
-        if (complexity) {
-            *complexity = 0;
-        }
-        if (result) {
-            *result = 0;
+    // Pick the first slot of a thread that didn't use this pool last
+    if (poolHint != poolObject) {
+        if (poolThreadId == UINT32_MAX) {
+            poolThreadId = atomic_fetch_add (&poolThreadCount, 1);
         }
-    } else {
+        poolHint = poolObject;
+        poolSlotIdHint = poolThreadId;
+    }
 
-        // Generate the solution
-        if (solutionOperations) {
-            numbersObject->solution.operations = solutionOperations;
-            GenerateSolution (numbersObject, numbersObject->solution.operationId);
-            *numbersObject->solution.operations = 0;
+    // Try each slot once, starting with the one this thread used last (the
+    // slot is only written to when it seems to be available, so that threads
+    // looking for an object don't fight over the cache lines of busy slots)
+    for (uint32_t slotCount = 0; slotCount < poolObject->slotCount; ++slotCount) {
+        uint32_t slotId = (poolSlotIdHint + slotCount) % poolObject->slotCount;
+        PoolSlot* slot = &poolObject->slots[slotId];
+        if (!atomic_load (&slot->acquired) && !atomic_exchange (&slot->acquired, TRUE)) {
+            poolSlotIdHint = slotId;
+            *numbersObject = slot->numbersObject;
+            return Success;
         }
-        if (complexity) {
-#ifndef DISABLE_COMPLEXITY
-            *complexity = numbersObject->operations[numbersObject->solution.operationId].complexity;
-#else
-            *complexity = 0;
-#endif
-        }
-        if (result) {
-            *result = numbersObject->operations[numbersObject->solution.operationId].result;
+    }
+
+    // All objects are in use
+    return EmptyPoolError;
+}
+
+// Release a Numbers library object to its pool
+extern NumbersError NumbersPoolRelease (NumbersPoolObject poolObject, NumbersObject numbersObject) {
+
+    // Check the pointers
+    if (!poolObject || !numbersObject) {
+        return NullPointerError;
+    }
+
+    // Find the slot of the object (usually the one this thread used last)
+    uint32_t slotIdFirst = poolHint == poolObject ? poolSlotIdHint : 0;
+    for (uint32_t slotCount = 0; slotCount < poolObject->slotCount; ++slotCount) {
+        uint32_t slotId = (slotIdFirst + slotCount) % poolObject->slotCount;
+        PoolSlot* slot = &poolObject->slots[slotId];
+        if (slot->numbersObject == numbersObject) {
+            if (!atomic_load (&slot->acquired)) {
+                return IncorrectObjectError;
+            }
+            poolSlotIdHint = slotId;
+            atomic_store (&slot->acquired, FALSE);
+            return Success;
         }
     }
-    return numbersObject->solution.aborted ? AbortedError : Success;
+
+    // The object doesn't belong to this pool
+    return IncorrectObjectError;
 }
 
 // Shuffle a set of tiles
@@ -562,8 +3870,69 @@ inline static void CheckResult (uint32_t target, uint32_t result, uint32_t* best
     }
 }
 
-// Validate a solution
-extern NumbersError NumbersValidate (uint32_t target, NumbersTiles* tiles, uint8_t* solutionOperations, uint32_t* bestResult, NumbersOperationHook operationHook) {
+// Validate an operation of a solution: make sure it uses 2 valid tiles which
+// haven't been used before, compute its result, then save this result in the
+// left tile and invalidate the right tile
+inline static NumbersError ValidateOperation (uint32_t tileCount, uint32_t* tileValues, uint8_t tileIdLeft, uint8_t tileIdRight, Operator op, NumbersOperation* operation) {
+
+    // Make sure the tile IDs are valid
+    if (tileIdLeft >= tileCount || tileIdRight >= tileCount || tileIdLeft == tileIdRight) {
+        return IncorrectTileIdError;
+    }
+
+    // Get the value of both tiles used in the operation
+    operation->valueLeft = tileValues[tileIdLeft];
+    operation->valueRight = tileValues[tileIdRight];
+
+    // Make sure these tiles have not been used before
+    if (operation->valueLeft == UINT32_MAX || operation->valueRight == UINT32_MAX) {
+        return TileUsedTwiceError;
+    }
+
+    // Compute the result of the operation
+    switch (op) {
+        case ADD:
+            operation->valueResult = operation->valueLeft + operation->valueRight;
+            if (operation->valueResult < operation->valueLeft) {
+                return OverflowError;
+            }
+            operation->opChar = '+';
+            break;
+        case MUL:
+            if ((uint64_t)operation->valueLeft * operation->valueRight > UINT32_MAX) {
+                return OverflowError;
+            }
+            operation->valueResult = operation->valueLeft * operation->valueRight;
+            operation->opChar = 'x';
+            break;
+        case SUB:
+            if (operation->valueLeft < operation->valueRight) {
+                return NegativeResultError;
+            }
+            operation->valueResult = operation->valueLeft - operation->valueRight;
+            operation->opChar = '-';
+            break;
+        default:
+            if (operation->valueRight == 0) {
+                return DivisionByZeroError;
+            }
+            operation->valueResult = operation->valueLeft / operation->valueRight;
+            if (operation->valueRight * operation->valueResult != operation->valueLeft) {
+                return RemainderNotNullError;
+            }
+            operation->opChar = '/';
+            break;
+    }
+
+    // Save the result in the left tile, and invalidate the right tile
+    tileValues[tileIdLeft] = operation->valueResult;
+    tileValues[tileIdRight] = UINT32_MAX;
+    return Success;
+}
+
+// Validate a solution (given either with the compact encoding or with the
+// extended one)
+static NumbersError Validate (uint32_t target, NumbersTiles* tiles, uint8_t* solutionOperations, uint16_t* solutionOperationsExtended, uint32_t* bestResult, NumbersOperationHook operationHook) {
 
     // Check the pointers
     if (!tiles || !bestResult) {
@@ -585,76 +3954,128 @@ extern NumbersError NumbersValidate (uint32_t target, NumbersTiles* tiles, uint8
     }
 
     // Check each operation
-    if (solutionOperations) {
-        while (*solutionOperations) {
+    while (1) {
+
+        // Get the tile IDs and operator
+        uint8_t tileIdLeft;
+        uint8_t tileIdRight;
+        Operator op;
+        if (solutionOperations && *solutionOperations) {
+            uint8_t operationEncoded = *solutionOperations++;
+            tileIdLeft = operationEncoded & 7;
+            tileIdRight = (operationEncoded >> 3) & 7;
+            op = (Operator)(operationEncoded >> 6);
+        } else if (solutionOperationsExtended && *solutionOperationsExtended) {
+            uint16_t operationEncoded = *solutionOperationsExtended++;
+            tileIdLeft = operationEncoded & 15;
+            tileIdRight = (operationEncoded >> 4) & 15;
+            op = (Operator)((operationEncoded >> 8) & 3);
+        } else {
+            break;
+        }
 
-            // Get the tile IDs and operator
-            uint8_t operationEncoded = *solutionOperations;
-            uint8_t tileIdLeft = operationEncoded & 7;
-            Operator op = (Operator)(operationEncoded >> 6);
-            uint8_t tileIdRight = (operationEncoded >> 3) & 7;
+        // Validate the operation
+        NumbersOperation operation;
+        NumbersError error = ValidateOperation (tiles->count, tileValues, tileIdLeft, tileIdRight, op, &operation);
+        if (error != Success) {
+            return error;
+        }
 
-            // Make sure the tile IDs are valid
-            if (tileIdLeft >= tiles->count || tileIdRight >= tiles->count || tileIdLeft == tileIdRight) {
-                return IncorrectTileIdError;
-            }
+        // Call the hook
+        if (operationHook) {
+            operationHook (&operation);
+        }
 
-            // Get the value of both tiles used in the operation
-            NumbersOperation operation;
-            operation.valueLeft = tileValues[tileIdLeft];
-            operation.valueRight = tileValues[tileIdRight];
+        // Check whether this is the best result so far
+        CheckResult (target, operation.valueResult, bestResult, &bestTargetDiff);
+    }
 
-            // Make sure these tiles have not been used before
-            if (operation.valueLeft == UINT32_MAX || operation.valueRight == UINT32_MAX) {
-                return TileUsedTwiceError;
-            }
+    // Done
+    return Success;
+}
 
-            // Compute the result of the operation
-            switch (op) {
-                case ADD:
-                    operation.valueResult = operation.valueLeft + operation.valueRight;
-                    operation.opChar = '+';
-                    break;
-                case MUL:
-                    operation.valueResult = operation.valueLeft * operation.valueRight;
-                    operation.opChar = 'x';
-                    break;
-                case SUB:
-                    if (operation.valueLeft < operation.valueRight) {
-                        return NegativeResultError;
-                    }
-                    operation.valueResult = operation.valueLeft - operation.valueRight;
-                    operation.opChar = '-';
-                    break;
-                default:
-                    if (operation.valueRight == 0) {
-                        return DivisionByZeroError;
-                    }
-                    operation.valueResult = operation.valueLeft / operation.valueRight;
-                    if (operation.valueRight * operation.valueResult != operation.valueLeft) {
-                        return RemainderNotNullError;
-                    }
-                    operation.opChar = '/';
-                    break;
-            }
+// Validate a solution
+extern NumbersError NumbersValidate (uint32_t target, NumbersTiles* tiles, uint8_t* solutionOperations, uint32_t* bestResult, NumbersOperationHook operationHook) {
+    return Validate (target, tiles, solutionOperations, NULL, bestResult, operationHook);
+}
 
-            // Call the hook
-            if (operationHook) {
-                operationHook (&operation);
-            }
+// Validate a solution (supporting more tiles)
+extern NumbersError NumbersValidateExtended (uint32_t target, NumbersTiles* tiles, uint16_t* solutionOperations, uint32_t* bestResult, NumbersOperationHook operationHook) {
+    return Validate (target, tiles, NULL, solutionOperations, bestResult, operationHook);
+}
+
+// Validate a solution of a batch (its tiles being copied and checked once for
+// all solutions of the batch, and its operations fitting in 8 bytes)
+static NumbersError ValidateBatchSolution (uint32_t target, uint32_t tileCount, uint32_t* tileValuesBatch, uint32_t bestTileResult, uint32_t bestTileTargetDiff, uint8_t* solutionOperations, uint32_t* bestResult) {
+
+    // Copy the tiles, starting from the best one
+    uint32_t tileValues[8];
+    memcpy (tileValues, tileValuesBatch, sizeof (tileValues));
+    *bestResult = bestTileResult;
+    uint32_t bestTargetDiff = bestTileTargetDiff;
+
+    // Check each operation
+    for (uint32_t operationId = 0; operationId < 8 && solutionOperations[operationId]; ++operationId) {
+
+        // Validate the operation
+        uint8_t operationEncoded = solutionOperations[operationId];
+        NumbersOperation operation;
+        NumbersError error = ValidateOperation (tileCount, tileValues,
+            operationEncoded & 7, (operationEncoded >> 3) & 7, (Operator)(operationEncoded >> 6), &operation);
+        if (error != Success) {
+            return error;
+        }
+
+        // Check whether this is the best result so far
+        CheckResult (target, operation.valueResult, bestResult, &bestTargetDiff);
+    }
+
+    // Done
+    return Success;
+}
 
-            // Save the result in the left tile, and invalidate the right tile
-            tileValues[tileIdLeft] = operation.valueResult;
-            tileValues[tileIdRight] = UINT32_MAX;
+// Validate several solutions of the same problem
+extern NumbersError NumbersValidateBatch (uint32_t target, NumbersTiles* tiles, uint32_t solutionCount, uint8_t* solutionOperations, NumbersError* errors, uint32_t* bestResults) {
 
-            // Check whether this is the best result so far
-            CheckResult (target, operation.valueResult, bestResult, &bestTargetDiff);
+    // Check the pointers
+    if (!tiles || !solutionOperations || !errors || !bestResults) {
+        return NullPointerError;
+    }
 
-            // Next operation
-            ++solutionOperations;
+    // Copy the tiles once for all solutions (only the first 8 tiles can be
+    // used by the operations), and find the best of them
+    uint32_t tileValues[8];
+    uint32_t bestTileResult = 0;
+    uint32_t bestTileTargetDiff = UINT32_MAX;
+    for (uint32_t tileId = 0; tileId < tiles->count; ++tileId) {
+        if (tileId < 8) {
+            tileValues[tileId] = tiles->values[tileId];
         }
+        CheckResult (target, tiles->values[tileId], &bestTileResult, &bestTileTargetDiff);
+    }
+    for (uint32_t tileId = tiles->count; tileId < 8; ++tileId) {
+        tileValues[tileId] = UINT32_MAX;
+    }
+
+    // Validate the solutions
+    for (uint32_t solutionId = 0; solutionId < solutionCount; ++solutionId) {
+        errors[solutionId] = ValidateBatchSolution (target, tiles->count, tileValues, bestTileResult, bestTileTargetDiff,
+            &solutionOperations[solutionId << 3], &bestResults[solutionId]);
     }
 
     // Done
     return Success;
 }
+
+// Functions of this variant of the library
+static const Variant variant = {
+    NumbersShutdown,
+    NumbersSolve,
+    NumbersSolveExtended,
+    NumbersSolveWithLimits,
+    NumbersGetStatistics,
+    NumbersSolveRange,
+    NumbersSolveTop,
+    NumbersSolvePareto,
+    NumbersSnapshotInitialize
+};
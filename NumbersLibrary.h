@@ -19,6 +19,21 @@
 // Numbers library object
 typedef struct NumbersStruct* NumbersObject;
 
+// Numbers cache object
+typedef struct NumbersCacheStruct* NumbersCacheObject;
+
+// Numbers snapshot object
+typedef struct NumbersSnapshotStruct* NumbersSnapshotObject;
+
+// Numbers batch object
+typedef struct NumbersBatchStruct* NumbersBatchObject;
+
+// Numbers pool object
+typedef struct NumbersPoolStruct* NumbersPoolObject;
+
+// Maximum number of tiles (when using NumbersSolveExtended)
+#define NUMBERS_TILE_COUNT_MAX 16
+
 // Errors
 typedef enum {
     Success = 0,
@@ -31,9 +46,27 @@ typedef enum {
     TileUsedTwiceError,
     NegativeResultError,
     DivisionByZeroError,
-    RemainderNotNullError
+    RemainderNotNullError,
+    ThreadError,
+    TooLargeSizeError,
+    InterruptedError,
+    EmptyPoolError,
+    IncorrectObjectError,
+    OverflowError
 } NumbersError;
 
+// Options (see NumbersInitializeWithOptions)
+typedef struct {
+    uint32_t operationSize;
+    uint32_t operationIdSize;
+    uint32_t threadCount;
+    uint32_t operationGrowth;
+    uint32_t disableResultHash;
+    uint32_t disableComplexity;
+    uint32_t checkOverflow;
+    uint32_t collectStatistics;
+} NumbersOptions;
+
 // Tiles
 typedef struct {
     uint32_t count;
@@ -48,6 +81,38 @@ typedef struct {
     uint32_t valueResult;
 } NumbersOperation;
 
+// Problems (see NumbersSolveBatch)
+typedef struct {
+    uint32_t target;
+    NumbersTiles tiles;
+    uint16_t complexity;
+} NumbersProblem;
+
+// Solutions (see NumbersSolveRange and NumbersSolveBatch)
+typedef struct {
+    uint32_t result;
+    uint16_t complexity;
+    uint8_t solutionOperations[8];
+} NumbersSolution;
+
+// Limits of a search (see NumbersSolveWithLimits)
+typedef struct {
+    uint32_t timeLimit;
+    uint64_t operationBudget;
+    volatile uint32_t* cancel;
+} NumbersLimits;
+
+// Statistics of a search (see NumbersGetStatistics)
+typedef struct {
+    uint32_t operationCounts[NUMBERS_TILE_COUNT_MAX];
+    uint32_t operationIdPeak;
+    uint32_t abortedTileCount;
+    uint64_t duplicateHits;
+    uint64_t duplicateMisses;
+    uint64_t outsideResults;
+    uint64_t complexityPruned;
+} NumbersStatistics;
+
 // Operation hook
 typedef void (*NumbersOperationHook)(NumbersOperation* operation);
 
@@ -63,6 +128,55 @@ typedef void (*NumbersOperationHook)(NumbersOperation* operation);
  */
 extern NumbersError NumbersInitialize (uint16_t operationSize, uint16_t operationIdSize, NumbersObject* numbersObject);
 
+/**
+ * Initialize the library with some options. NumbersInitialize is equivalent to
+ * calling this function with threadCount = 1, operationGrowth = 0,
+ * disableResultHash = 0, disableComplexity = 0, checkOverflow = 0 and
+ * collectStatistics = 0.
+ * @param options Options of the solver:
+ * - operationSize and operationIdSize are the same as for NumbersInitialize,
+ * except that they aren't limited to 16 bits (operation IDs are stored on 32
+ * bits, unless the library is built with ENABLE_16BIT_OPERATION_IDS, which
+ * saves some memory for small problems);
+ * - threadCount is the number of threads used by NumbersSolve (when greater
+ * than 1, the groups of operations of each layer are combined in parallel,
+ * each thread recording its operations in its own arrays; this allows a single
+ * call to NumbersSolve to use several cores, at the cost of (threadCount - 1)
+ * extra threads and threadCount times more memory);
+ * - operationGrowth is the number of operations added to the arrays whenever
+ * they are full: when 0, the size of the arrays is fixed and NumbersSolve
+ * aborts its search when they are full, otherwise operationSize is only a hint
+ * and NumbersSolve never aborts (unless there is no memory left).
+ * - disableResultHash shall be 0 to find duplicate results using a hash set
+ * when they don't fit in the array of operation IDs (i.e. when they are
+ * greater than or equal to operationIdSize), otherwise such duplicate results
+ * are recorded and combined over and over (this is mostly useful to benchmark
+ * both approaches).
+ * - disableComplexity shall be 0 to track the complexity of the operations,
+ * otherwise the object doesn't track it, which makes it faster (complexities
+ * of solutions are then always 0, and maximum complexities are ignored).
+ * - checkOverflow shall be 0 to let additions and multiplications wrap around
+ * (as 32-bit unsigned integers), which is fine as long as the tiles are small
+ * enough (e.g. in the standard game), otherwise the object discards the
+ * operations which overflow, so that it never proposes wrong solutions, at the
+ * cost of a slower search (such objects don't use vector instructions).
+ * - collectStatistics shall be 0 to skip counting the events of the searches
+ * which only diagnostics need, otherwise the object counts them (see
+ * NumbersGetStatistics), at the cost of a slower search (such objects don't
+ * use vector instructions, and this option is ignored when checkOverflow
+ * isn't 0).
+ * The library is compiled in several variants (with or without complexity,
+ * checking overflows or collecting statistics, and using the vector
+ * instructions of various processors: AVX2, SSE4.2, or none); the variant that
+ * suits the options and the processor best is picked once per object, so that
+ * the search itself never checks them.
+ * @param numbersObject Numbers library object (out).
+ * @return Success if the library could be initialized successfully,
+ * TooLargeSizeError if operationSize exceeds the range of operation IDs, or
+ * ThreadError if the worker threads could not be created.
+ */
+extern NumbersError NumbersInitializeWithOptions (NumbersOptions* options, NumbersObject* numbersObject);
+
 /**
  * Shut down the library, freeing the memory allocated during its
  * initialization. This function should be called once after the final call to
@@ -90,15 +204,390 @@ extern NumbersError NumbersShutdown (NumbersObject numbersObject);
  * @param result Number reached by the solver.
  * @return Success if the game could be solved successfully, AbortedError if
  * the number of operations to analyze was greater than the allocated memory
- * (forcing the solver to abort its search), NullPointerError if numbersObject
- * or tiles is a NULL pointer, or TooManyTilesError if there are too many tiles.
+ * (forcing the solver to abort its search; this doesn't happen when the arrays
+ * of operations are allowed to grow, see NumbersInitializeWithOptions),
+ * NullPointerError if numbersObject or tiles is a NULL pointer,
+ * TooManyTilesError if there are too many tiles, or MemoryAllocationError if
+ * the groups of operations could not be allocated.
  */
 extern NumbersError NumbersSolve (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result);
 
+/**
+ * Solve the game, with up to NUMBERS_TILE_COUNT_MAX tiles. This function is
+ * the same as NumbersSolve, except for the encoding of the solution.
+ * Note: the memory required by the solver grows quickly with the number of
+ * tiles (there are 2^N groups of tiles, and a lot more operations to analyze),
+ * hence the need to allow the arrays of operations to grow when using more
+ * than 8 tiles (see NumbersInitializeWithOptions).
+ * @param numbersObject Numbers library object used to solve the game.
+ * @param target Target number.
+ * @param tiles Set of tiles. There shall not be more than
+ * NUMBERS_TILE_COUNT_MAX tiles.
+ * @param complexity Maximum complexity of the solution (in) / actual
+ * complexity of the solution (out).
+ * @param solutionOperations Array which stores the solution. Each operation is
+ * stored on 2 bytes (bits 0-3 represent the index of the left tile, bits 4-7
+ * the index of the right tile, bits 8-9 the operator, and bits 10-15 are 0);
+ * the array shall have room for tiles->count operations, and the end of the
+ * solution is marked with operation 0.
+ * @param result Number reached by the solver.
+ * @return Same as NumbersSolve.
+ */
+extern NumbersError NumbersSolveExtended (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint16_t* solutionOperations, uint32_t* result);
+
+/**
+ * Solve the game within some limits, to bound the time spent searching for a
+ * solution. This function is the same as NumbersSolve, except that the search
+ * stops as soon as a limit is exceeded: since tiles are combined in layers
+ * (first all combinations of 2 tiles, then of 3 tiles, and so on), the best
+ * solution found so far is returned, which is usually close to the target.
+ * Limits are checked each time 2 groups of operations are about to be
+ * combined.
+ * @param numbersObject Numbers library object used to solve the game.
+ * @param target Target number.
+ * @param tiles Set of tiles. There shall not be more than 8 tiles.
+ * @param limits Limits of the search (each of them being ignored when 0):
+ * - timeLimit is the maximum duration of the search, in microseconds;
+ * - operationBudget is the maximum number of pairs of operations combined
+ * (each pair giving up to 6 new operations);
+ * - cancel points to a flag which another thread can set (to any value but 0,
+ * e.g. with __atomic_store_n) to stop the search; the library only reads it
+ * atomically.
+ * @param complexity Maximum complexity of the solution (in) / actual
+ * complexity of the solution (out).
+ * @param solutionOperations Array which stores the solution (same encoding as
+ * for NumbersSolve).
+ * @param result Number reached by the solver.
+ * @return Same as NumbersSolve, or InterruptedError if the search exceeded a
+ * limit (the solution being the best one found before the search stopped),
+ * and NullPointerError if limits is a NULL pointer.
+ */
+extern NumbersError NumbersSolveWithLimits (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, NumbersLimits* limits, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result);
+
+/**
+ * Get the statistics of the last search performed by an object (by any of the
+ * functions solving the game with it), e.g. to size its arrays, or to find the
+ * sets of tiles that are the hardest to solve.
+ * @param numbersObject Numbers library object.
+ * @param statistics Statistics of the search (out):
+ * - operationCounts is the number of operations recorded in each layer (the
+ * first entry being the layer of the tiles alone, the second one the layer of
+ * combinations of 2 tiles, and so on; the final layer only records its best
+ * operation);
+ * - operationIdPeak is the number of operations recorded overall, i.e. the
+ * operationSize the search needed (when the search gets aborted because the
+ * arrays are full, solving the same game with an object allowing the arrays to
+ * grow gives the size required, see NumbersInitializeWithOptions);
+ * - abortedTileCount is the number of tiles of the layer in which the search
+ * got aborted or interrupted, or 0 if it completed;
+ * - duplicateHits and duplicateMisses are the number of times the result of
+ * a new operation was found or not found among the results already recorded
+ * in its group (results are only searched when they don't beat the best
+ * solution so far);
+ * - outsideResults is the number of operations recorded with a result that
+ * doesn't fit in the array of operation IDs (see operationIdSize), whose
+ * duplicates are found through a hash set (if any);
+ * - complexityPruned is the number of pairs of results, and of single
+ * operations, discarded because their complexity exceeds the maximum.
+ * The last 4 counters are only collected by objects initialized with the
+ * collectStatistics option, so that searches don't pay for them otherwise
+ * (they are always 0 then).
+ * @return Success if the statistics could be retrieved, or NullPointerError if
+ * numbersObject or statistics is a NULL pointer.
+ */
+extern NumbersError NumbersGetStatistics (NumbersObject numbersObject, NumbersStatistics* statistics);
+
+/**
+ * Solve the game for all targets of a range at once. Rather than searching for
+ * the solution of each target (stopping when the target is reached), this
+ * function records all possible operations once, then picks the closest result
+ * to each target: it is a lot faster than calling NumbersSolve for each
+ * target, but it requires more memory (allowing the arrays of operations to
+ * grow is recommended, see NumbersInitializeWithOptions).
+ * Note: when 2 results are at the same distance from a target, the one which
+ * uses the fewest tiles wins, then the one with the lowest complexity, then
+ * the smallest one; hence the solution may differ from the one proposed by
+ * NumbersSolve (but it is as close to the target).
+ * @param numbersObject Numbers library object used to solve the game.
+ * @param targetFirst First target of the range.
+ * @param targetLast Last target of the range (included).
+ * @param tiles Set of tiles. There shall not be more than 8 tiles.
+ * @param complexityMax Maximum complexity of the solutions (UINT16_MAX to be
+ * sure to get the best solutions).
+ * @param solutions Array which stores the solutions (result, complexity, and
+ * operations encoded as for NumbersSolve), with 1 entry per target of the
+ * range.
+ * @return Success if the game could be solved successfully for all targets,
+ * AbortedError if the number of operations was greater than the allocated
+ * memory (solutions are then based on the operations recorded before the
+ * search got aborted), NullPointerError if numbersObject, tiles or solutions
+ * is a NULL pointer, TooManyTilesError if there are too many tiles,
+ * ZeroSizeError if targetFirst is greater than targetLast, TooLargeSizeError
+ * if the range covers all 32-bit numbers, or MemoryAllocationError if there
+ * isn't enough memory.
+ */
+extern NumbersError NumbersSolveRange (NumbersObject numbersObject, uint32_t targetFirst, uint32_t targetLast, NumbersTiles* tiles, uint16_t complexityMax, NumbersSolution* solutions);
+
+/**
+ * Solve the game, getting the best distinct solutions at once. All possible
+ * operations are recorded once (as for NumbersSolveRange), then the best ones
+ * are kept: the solutions are sorted from the closest to the target to the
+ * farthest, then from the simplest to the most complex, then from the one
+ * which uses the fewest tiles to the one which uses the most. Each solution is
+ * a distinct way to combine the tiles (several solutions may give the same
+ * result), hence there is no need to shuffle the tiles and solve the game again
+ * to get alternative solutions. Ways which get at least as close to the target
+ * before reaching their result (through a tile or an intermediate result) are
+ * skipped, so that NumbersValidate reports the result of each solution.
+ * @param numbersObject Numbers library object used to solve the game.
+ * @param target Target number.
+ * @param tiles Set of tiles. There shall not be more than 8 tiles.
+ * @param complexityMax Maximum complexity of the solutions.
+ * @param solutionCountMax Maximum number of solutions.
+ * @param solutions Array which stores the solutions (result, complexity, and
+ * operations encoded as for NumbersSolve), with room for solutionCountMax
+ * entries.
+ * @param solutionCount Actual number of solutions (out).
+ * @return Success if the game could be solved successfully, AbortedError if
+ * the number of operations was greater than the allocated memory (solutions are
+ * then based on the operations recorded before the search got aborted),
+ * NullPointerError if numbersObject, tiles, solutions or solutionCount is a
+ * NULL pointer, TooManyTilesError if there are too many tiles, ZeroSizeError if
+ * solutionCountMax is 0, or MemoryAllocationError if there isn't enough memory.
+ */
+extern NumbersError NumbersSolveTop (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint16_t complexityMax, uint32_t solutionCountMax, NumbersSolution* solutions, uint32_t* solutionCount);
+
+/**
+ * Solve the game for all maximum complexities at once, getting the Pareto
+ * frontier of the problem: all possible operations are recorded once (as for
+ * NumbersSolveRange), then the solutions are sorted by complexity, each of
+ * them being strictly closer to the target than all the simpler ones (and
+ * being the simplest way to get this close). The best solution for a given
+ * maximum complexity is then the most complex solution of the frontier which
+ * doesn't exceed it (see NumbersSelectPareto), which allows to serve players
+ * of any skill level without solving the game again.
+ * Note: when 2 results are at the same distance from the target and have the
+ * same complexity, the one which uses the fewest tiles wins.
+ * @param numbersObject Numbers library object used to solve the game.
+ * @param target Target number.
+ * @param tiles Set of tiles. There shall not be more than 8 tiles.
+ * @param solutionCountMax Maximum number of solutions.
+ * @param solutions Array which stores the solutions of the frontier (result,
+ * complexity, and operations encoded as for NumbersSolve), from the simplest
+ * to the closest to the target, with room for solutionCountMax entries.
+ * @param solutionCount Actual number of solutions of the frontier (out; it
+ * can be greater than solutionCountMax).
+ * @return Success if the game could be solved successfully, AbortedError if
+ * the number of operations was greater than the allocated memory (solutions are
+ * then based on the operations recorded before the search got aborted),
+ * NullPointerError if numbersObject, tiles or solutionCount is a NULL pointer
+ * (or solutions, unless solutionCountMax is 0), TooManyTilesError if there are
+ * too many tiles, TooLargeSizeError if the frontier has more than
+ * solutionCountMax solutions (only the simplest ones being stored), or
+ * MemoryAllocationError if there isn't enough memory.
+ */
+extern NumbersError NumbersSolvePareto (NumbersObject numbersObject, uint32_t target, NumbersTiles* tiles, uint32_t solutionCountMax, NumbersSolution* solutions, uint32_t* solutionCount);
+
+/**
+ * Pick the best solution for a given maximum complexity, from a Pareto frontier
+ * given by NumbersSolvePareto.
+ * @param solutionCount Number of solutions of the frontier.
+ * @param solutions Array which stores the solutions of the frontier.
+ * @param complexity Maximum complexity of the solution (in) / actual
+ * complexity of the solution (out).
+ * @param solutionOperations Array which stores the solution (same encoding as
+ * for NumbersSolve).
+ * @param result Number reached by the solution.
+ * @return Success if a solution could be picked (all outputs are 0 if no
+ * solution of the frontier is simple enough), or NullPointerError if solutions
+ * is a NULL pointer while solutionCount isn't 0.
+ */
+extern NumbersError NumbersSelectPareto (uint32_t solutionCount, NumbersSolution* solutions, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result);
+
+/**
+ * Initialize a cache of solutions, which can be shared by several threads
+ * (each of them using its own Numbers library object to solve the problems
+ * missing from the cache).
+ * @param entryCount Maximum number of problems recorded in the cache (when it
+ * is full, the least recently used problems get replaced).
+ * @param cacheObject Numbers cache object (out).
+ * @return Success if the cache could be initialized successfully.
+ */
+extern NumbersError NumbersCacheInitialize (uint32_t entryCount, NumbersCacheObject* cacheObject);
+
+/**
+ * Shut down a cache, freeing its memory. This function shall be called once no
+ * thread uses the cache anymore.
+ * @param cacheObject Numbers cache object to shut down.
+ * @return Success if the cache could be shut down successfully.
+ */
+extern NumbersError NumbersCacheShutdown (NumbersCacheObject cacheObject);
+
+/**
+ * Solve the game, using a cache: the solution of a problem is only searched
+ * once for a given set of tiles (whatever their order), target and maximum
+ * complexity (and depending on whether the object tracks complexity), then it
+ * is taken from the cache. This function is the same as
+ * NumbersSolve otherwise, except that shuffling the tiles doesn't give
+ * alternative solutions (the solution always refers to the tiles given by the
+ * caller, though).
+ * @param numbersObject Numbers library object used to solve the game when the
+ * problem isn't in the cache.
+ * @param cacheObject Numbers cache object.
+ * @param target Target number.
+ * @param tiles Set of tiles. There shall not be more than 8 tiles.
+ * @param complexity Maximum complexity of the solution (in) / actual
+ * complexity of the solution (out).
+ * @param solutionOperations Array which stores the solution (same encoding as
+ * for NumbersSolve).
+ * @param result Number reached by the solver.
+ * @return Same as NumbersSolve (solutions of aborted searches are not
+ * recorded in the cache).
+ */
+extern NumbersError NumbersSolveCached (NumbersObject numbersObject, NumbersCacheObject cacheObject, uint32_t target, NumbersTiles* tiles, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result);
+
+/**
+ * Initialize a snapshot of all the operations that can be performed with a set
+ * of tiles. Once initialized, a snapshot never changes: it can be used to solve
+ * the game for any number of targets and maximum complexities (see
+ * NumbersSolveSnapshot), by several threads at once, without searching again.
+ * Allowing the arrays of operations to grow is recommended, since all possible
+ * operations get recorded (see NumbersInitializeWithOptions).
+ * @param numbersObject Numbers library object used to record the operations
+ * (it is not needed by the snapshot afterwards).
+ * @param tiles Set of tiles. There shall not be more than 8 tiles.
+ * @param snapshotObject Numbers snapshot object (out).
+ * @return Success if the snapshot could be initialized successfully,
+ * AbortedError if the number of operations was greater than the allocated
+ * memory (the snapshot is initialized anyway, but it only holds the operations
+ * recorded before the search got aborted), NullPointerError if numbersObject
+ * or tiles is a NULL pointer, TooManyTilesError if there are too many tiles,
+ * or MemoryAllocationError if there isn't enough memory.
+ */
+extern NumbersError NumbersSnapshotInitialize (NumbersObject numbersObject, NumbersTiles* tiles, NumbersSnapshotObject* snapshotObject);
+
+/**
+ * Shut down a snapshot, freeing its memory. This function shall be called once
+ * no thread uses the snapshot anymore.
+ * @param snapshotObject Numbers snapshot object to shut down.
+ * @return Success if the snapshot could be shut down successfully.
+ */
+extern NumbersError NumbersSnapshotShutdown (NumbersSnapshotObject snapshotObject);
+
+/**
+ * Solve the game, using a snapshot of the operations of its set of tiles. This
+ * function is the same as NumbersSolve otherwise, except that when 2 results
+ * are at the same distance from the target, the same rules as for
+ * NumbersSolveRange apply.
+ * @param snapshotObject Numbers snapshot object.
+ * @param target Target number.
+ * @param complexity Maximum complexity of the solution (in) / actual
+ * complexity of the solution (out).
+ * @param solutionOperations Array which stores the solution (same encoding as
+ * for NumbersSolve).
+ * @param result Number reached by the solver.
+ * @return Success if the game could be solved successfully, or
+ * NullPointerError if snapshotObject is a NULL pointer.
+ */
+extern NumbersError NumbersSolveSnapshot (NumbersSnapshotObject snapshotObject, uint32_t target, uint16_t* complexity, uint8_t* solutionOperations, uint32_t* result);
+
+/**
+ * Initialize a batch object, which solves batches of problems using several
+ * threads. The threads are created once, each of them with its own Numbers
+ * library object; when solving a batch, each thread takes problems from its
+ * own share of the batch, then from the shares of the other threads once its
+ * own share is done.
+ * @param options Options of the Numbers library object of each thread (see
+ * NumbersInitializeWithOptions; threadCount should usually be 1, the threads of
+ * the batch object being enough to use several cores).
+ * @param threadCount Number of threads (including the thread calling
+ * NumbersSolveBatch).
+ * @param batchObject Numbers batch object (out).
+ * @return Success if the batch object could be initialized successfully,
+ * ZeroSizeError if threadCount is 0, ThreadError if the threads could not be
+ * created, or any error returned by NumbersInitializeWithOptions.
+ */
+extern NumbersError NumbersBatchInitialize (NumbersOptions* options, uint32_t threadCount, NumbersBatchObject* batchObject);
+
+/**
+ * Shut down a batch object, stopping its threads and freeing its memory.
+ * @param batchObject Numbers batch object to shut down.
+ * @return Success if the batch object could be shut down successfully.
+ */
+extern NumbersError NumbersBatchShutdown (NumbersBatchObject batchObject);
+
+/**
+ * Solve a batch of problems, using all the threads of a batch object. Each
+ * problem is solved as with NumbersSolve. A batch object shall not be used by
+ * several threads at once.
+ * @param batchObject Numbers batch object.
+ * @param problemCount Number of problems.
+ * @param problems Array of problems (target, set of tiles with no more than 8
+ * tiles, and maximum complexity of the solution).
+ * @param errors Array which stores the error returned by NumbersSolve for each
+ * problem.
+ * @param solutions Array which stores the solution of each problem (result,
+ * actual complexity, and operations encoded as for NumbersSolve; all 0 when the
+ * problem could not be solved).
+ * @return Success if all problems could be processed (check errors to know
+ * whether each of them could be solved), or NullPointerError if batchObject,
+ * problems, errors or solutions is a NULL pointer.
+ */
+extern NumbersError NumbersSolveBatch (NumbersBatchObject batchObject, uint32_t problemCount, NumbersProblem* problems, NumbersError* errors, NumbersSolution* solutions);
+
+/**
+ * Initialize a pool of Numbers library objects, which lets several threads
+ * share a fixed set of objects initialized once (e.g. a server solving bursts
+ * of concurrent problems, without initializing and shutting down an object for
+ * each of them).
+ * @param options Options of each Numbers library object (see
+ * NumbersInitializeWithOptions).
+ * @param objectCount Number of objects (i.e. maximum number of threads using
+ * the pool at the same time).
+ * @param poolObject Numbers pool object (out).
+ * @return Success if the pool could be initialized successfully, ZeroSizeError
+ * if objectCount is 0, or any error returned by NumbersInitializeWithOptions.
+ */
+extern NumbersError NumbersPoolInitialize (NumbersOptions* options, uint32_t objectCount, NumbersPoolObject* poolObject);
+
+/**
+ * Shut down a pool, shutting down all its Numbers library objects (none of
+ * them shall still be acquired).
+ * @param poolObject Numbers pool object to shut down.
+ * @return Success if the pool could be shut down successfully.
+ */
+extern NumbersError NumbersPoolShutdown (NumbersPoolObject poolObject);
+
+/**
+ * Acquire a Numbers library object from a pool. The object belongs to the
+ * calling thread until it releases it with NumbersPoolRelease. This function
+ * never blocks nor takes any lock; each thread first tries to get the object it
+ * released last, so that it keeps working with memory that is likely to be in
+ * the cache of its core.
+ * @param poolObject Numbers pool object.
+ * @param numbersObject Numbers library object (out).
+ * @return Success if an object could be acquired, or EmptyPoolError if all the
+ * objects of the pool are in use.
+ */
+extern NumbersError NumbersPoolAcquire (NumbersPoolObject poolObject, NumbersObject* numbersObject);
+
+/**
+ * Release a Numbers library object to its pool, making it available to other
+ * threads. The object may be released by another thread than the one that
+ * acquired it.
+ * @param poolObject Numbers pool object.
+ * @param numbersObject Numbers library object, acquired with
+ * NumbersPoolAcquire.
+ * @return Success if the object could be released, or IncorrectObjectError if
+ * it doesn't belong to the pool or isn't acquired.
+ */
+extern NumbersError NumbersPoolRelease (NumbersPoolObject poolObject, NumbersObject numbersObject);
+
 /**
  * Shuffle a set of tiles. This allows to get different solutions for a given
  * problem (although NumbersSolve will always return the best solution
- * possible, order of operations to get to the result may differ).
+ * possible, order of operations to get to the result may differ; see
+ * NumbersSolveTop to get several solutions from a single search).
  * @param tiles Set of tiles to be shuffled.
  * @param randomObject PRNG used to shuffle the tiles.
  * @return Success if the tiles could be shuffled successfully.
@@ -121,9 +610,50 @@ extern NumbersError NumbersShuffle (NumbersTiles* tiles, RandomObject randomObje
  * target number.
  * @param operationHook Function called at each step of the resolution (i.e.
  * once for each operation).
- * @return Success if the solution is valid.
+ * @return Success if the solution is valid, or the error of its first invalid
+ * operation (e.g. OverflowError if the result of an addition or a
+ * multiplication doesn't fit in 32 bits).
  */
 extern NumbersError NumbersValidate (uint32_t target, NumbersTiles* tiles, uint8_t* solutionOperations, uint32_t* bestResult, NumbersOperationHook operationHook);
 
+/**
+ * Validate a solution proposed by NumbersSolveExtended (or encoded in the same
+ * way). This function is the same as NumbersValidate, except for the encoding
+ * of the solution.
+ * @param target Target number.
+ * @param tiles Set of tiles.
+ * @param solutionOperations Array which stores the solution. Each operation is
+ * stored on 2 bytes (bits 0-3 represent the index of the left tile, bits 4-7
+ * the index of the right tile, and bits 8-9 the operator); the end of the
+ * solution is marked with operation 0.
+ * @param bestResult Result (or tile) which the value is the closest to the
+ * target number.
+ * @param operationHook Function called at each step of the resolution.
+ * @return Success if the solution is valid.
+ */
+extern NumbersError NumbersValidateExtended (uint32_t target, NumbersTiles* tiles, uint16_t* solutionOperations, uint32_t* bestResult, NumbersOperationHook operationHook);
+
+/**
+ * Validate several solutions of the same problem (e.g. all the solutions
+ * proposed by the players of a game). Each solution is validated as with
+ * NumbersValidate (without any hook), but the tiles are only copied and
+ * checked once for all solutions.
+ * @param target Target number.
+ * @param tiles Set of tiles.
+ * @param solutionCount Number of solutions.
+ * @param solutionOperations Array which stores the solutions, each of them on
+ * 8 bytes (same encoding as for NumbersValidate, the end of each solution
+ * being marked with byte 0 unless it uses all 8 bytes).
+ * @param errors Array which stores the error returned by NumbersValidate for
+ * each solution.
+ * @param bestResults Array which stores the best result of each solution (if
+ * a solution isn't valid, this is the best result before its first invalid
+ * operation).
+ * @return Success if all solutions could be processed (check errors to know
+ * whether each of them is valid), or NullPointerError if tiles,
+ * solutionOperations, errors or bestResults is a NULL pointer.
+ */
+extern NumbersError NumbersValidateBatch (uint32_t target, NumbersTiles* tiles, uint32_t solutionCount, uint8_t* solutionOperations, NumbersError* errors, uint32_t* bestResults);
+
 // Include guard
 #endif // NUMBERS_LIBRARY_H
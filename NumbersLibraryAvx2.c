@@ -0,0 +1,7 @@
+// Nicolas Robert [Nrx]
+
+// Variant of the Numbers library using AVX2 instructions (this file shall be
+// compiled with -mavx2; the complete library picks this variant when the
+// processor supports these instructions)
+#define NUMBERS_VARIANT Avx2
+#include "NumbersLibrary.c"
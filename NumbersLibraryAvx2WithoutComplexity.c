@@ -0,0 +1,7 @@
+// Nicolas Robert [Nrx]
+
+// Variant of the Numbers library using AVX2 instructions, without complexity
+// (this file shall be compiled with -mavx2)
+#define DISABLE_COMPLEXITY
+#define NUMBERS_VARIANT Avx2WithoutComplexity
+#include "NumbersLibrary.c"
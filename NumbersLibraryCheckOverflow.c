@@ -0,0 +1,10 @@
+// Nicolas Robert [Nrx]
+
+// Variant of the Numbers library that discards the operations which overflow
+// (only the scalar code checks them, hence this file shall be compiled without
+// any option enabling vector instructions; the complete library calls its
+// functions for the objects initialized with the checkOverflow option, see
+// NumbersInitializeWithOptions)
+#define CHECK_OVERFLOW
+#define NUMBERS_VARIANT CheckOverflow
+#include "NumbersLibrary.c"
@@ -0,0 +1,8 @@
+// Nicolas Robert [Nrx]
+
+// Variant of the Numbers library that discards the operations which overflow,
+// without complexity
+#define CHECK_OVERFLOW
+#define DISABLE_COMPLEXITY
+#define NUMBERS_VARIANT CheckOverflowWithoutComplexity
+#include "NumbersLibrary.c"
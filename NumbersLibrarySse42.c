@@ -0,0 +1,7 @@
+// Nicolas Robert [Nrx]
+
+// Variant of the Numbers library using SSE4.2 instructions (this file shall be
+// compiled with -msse4.2; the complete library picks this variant when the
+// processor supports these instructions but not AVX2)
+#define NUMBERS_VARIANT Sse42
+#include "NumbersLibrary.c"
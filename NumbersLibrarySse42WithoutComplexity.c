@@ -0,0 +1,7 @@
+// Nicolas Robert [Nrx]
+
+// Variant of the Numbers library using SSE4.2 instructions, without complexity
+// (this file shall be compiled with -msse4.2)
+#define DISABLE_COMPLEXITY
+#define NUMBERS_VARIANT Sse42WithoutComplexity
+#include "NumbersLibrary.c"
@@ -0,0 +1,9 @@
+// Nicolas Robert [Nrx]
+
+// Variant of the Numbers library that counts the events of its searches (the
+// complete library calls its functions for the objects initialized with the
+// collectStatistics option, see NumbersInitializeWithOptions and
+// NumbersGetStatistics)
+#define ENABLE_STATISTICS
+#define NUMBERS_VARIANT Statistics
+#include "NumbersLibrary.c"
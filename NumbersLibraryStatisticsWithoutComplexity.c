@@ -0,0 +1,8 @@
+// Nicolas Robert [Nrx]
+
+// Variant of the Numbers library that counts the events of its searches,
+// without complexity
+#define ENABLE_STATISTICS
+#define DISABLE_COMPLEXITY
+#define NUMBERS_VARIANT StatisticsWithoutComplexity
+#include "NumbersLibrary.c"
@@ -0,0 +1,10 @@
+// Nicolas Robert [Nrx]
+
+// Variant of the Numbers library that doesn't track the complexity of the
+// operations, which makes it faster: it is compiled from the same source as
+// the complete library, its functions being renamed (the complete library
+// calls them for the objects initialized with the disableComplexity option,
+// see NumbersInitializeWithOptions)
+#define DISABLE_COMPLEXITY
+#define NUMBERS_VARIANT WithoutComplexity
+#include "NumbersLibrary.c"
@@ -18,6 +18,7 @@ typedef enum {
     UNIT_TEST,
     RANDOM_TEST,
     FULL_TEST,
+    CHECK_TEST,
     ERROR
 } Test;
 
@@ -285,14 +286,687 @@ static void FullTest (NumbersObject numbersObject, RandomObject randomObject, ui
     }
 }
 
+// Define the options of the solvers used by the tests (letting their arrays
+// grow, so that they never abort their search)
+static NumbersOptions OptionsDefine (uint32_t threadCount) {
+    NumbersOptions options = {.operationSize = 25000, .operationIdSize = 15000, .threadCount = threadCount, .operationGrowth = 25000};
+    return options;
+}
+
+// Draw a random problem (up to 6 tiles taken from the usual set of tiles)
+static uint32_t ProblemDraw (RandomObject randomObject, uint32_t* tileValues, NumbersTiles* tiles) {
+
+    // Shuffle the set of tiles
+    const uint32_t tileSet[] = {1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 25, 50, 75, 100};
+    memcpy (tileValues, tileSet, sizeof (tileSet));
+    tiles->count = sizeof (tileSet) / sizeof (tileSet[0]);
+    tiles->values = tileValues;
+    NumbersShuffle (tiles, randomObject);
+
+    // Keep some of the tiles
+    tiles->count = 2 + (RandomGetValue (randomObject) % 5);
+
+    // Define the target
+    return 101 + (RandomGetValue (randomObject) % 899);
+}
+
+// Show a problem for which a check failed
+static void CheckFailure (const char* checkName, uint32_t target, NumbersTiles* tiles) {
+    printf ("%s check failed: >> %u <<", checkName, target);
+    for (uint32_t tileId = 0; tileId < tiles->count; ++tileId) {
+        printf (" [%u]", tiles->values[tileId]);
+    }
+    puts ("");
+}
+
+// Solve a problem with 2 objects, and compare their solutions (return 0 if
+// both objects solved the problem successfully and found the same solution)
+static int SolutionsCompare (NumbersObject numbersObjectA, NumbersObject numbersObjectB, uint32_t target, NumbersTiles* tiles) {
+    NumbersObject numbersObjects[2] = {numbersObjectA, numbersObjectB};
+    NumbersError errors[2];
+    uint16_t complexities[2];
+    uint8_t solutionOperations[2][NUMBERS_TILE_COUNT_MAX] = {{0}};
+    uint32_t results[2];
+    for (uint32_t objectId = 0; objectId < 2; ++objectId) {
+        complexities[objectId] = UINT16_MAX;
+        errors[objectId] = NumbersSolve (numbersObjects[objectId], target, tiles, &complexities[objectId], solutionOperations[objectId], &results[objectId]);
+    }
+    return errors[0] != Success || errors[1] != Success || results[0] != results[1] || complexities[0] != complexities[1]
+        || memcmp (solutionOperations[0], solutionOperations[1], tiles->count);
+}
+
+// Check that the solutions do not depend on the number of threads
+static uint32_t ThreadCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+
+    // Initialize another solver, using several threads
+    NumbersObject numbersObjects[2] = {numbersObject, NULL};
+    NumbersOptions options = OptionsDefine (4);
+    if (NumbersInitializeWithOptions (&options, &numbersObjects[1]) != Success) {
+        puts ("Error: Could not initialize the solver.");
+        return 1;
+    }
+
+    // Solve random problems with both solvers
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+
+        // The solutions shall be identical
+        if (SolutionsCompare (numbersObjects[0], numbersObjects[1], target, &tiles)) {
+            CheckFailure ("Thread", target, &tiles);
+            ++failureCount;
+        }
+    }
+
+    // Shut down the other solver
+    NumbersShutdown (numbersObjects[1]);
+    return failureCount;
+}
+
+// Get the distance between a result and the target
+static uint32_t TargetDiff (uint32_t target, uint32_t result) {
+    return result > target ? result - target : target - result;
+}
+
+// Check that a solution validates to its own result, and that this result is
+// as close to the target as a reference result
+static int IsSolutionCorrect (uint32_t target, NumbersTiles* tiles, uint8_t* solutionOperations, uint32_t result, uint32_t resultReference) {
+    uint32_t bestResult;
+    return NumbersValidate (target, tiles, solutionOperations, &bestResult, NULL) == Success
+        && bestResult == result
+        && TargetDiff (target, result) == TargetDiff (target, resultReference);
+}
+
+// Check that the solutions of a range of targets are as good as the ones of
+// NumbersSolve
+static uint32_t RangeCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+
+        // Solve the game for a range of targets
+        NumbersSolution solutions[10];
+        uint32_t solutionCount = sizeof (solutions) / sizeof (solutions[0]);
+        int failure = NumbersSolveRange (numbersObject, target, target + solutionCount - 1, &tiles, UINT16_MAX, solutions) != Success;
+
+        // Solve the game for each of these targets
+        for (uint32_t solutionId = 0; solutionId < solutionCount && !failure; ++solutionId) {
+            uint16_t complexity = UINT16_MAX;
+            uint8_t solutionOperations[NUMBERS_TILE_COUNT_MAX] = {0};
+            uint32_t result;
+            if (NumbersSolve (numbersObject, target + solutionId, &tiles, &complexity, solutionOperations, &result) != Success
+                || !IsSolutionCorrect (target + solutionId, &tiles, solutions[solutionId].solutionOperations, solutions[solutionId].result, result)
+                || solutions[solutionId].complexity != complexity) {
+                failure = 1;
+            }
+        }
+        if (failure) {
+            CheckFailure ("Range", target, &tiles);
+            ++failureCount;
+        }
+    }
+    return failureCount;
+}
+
+// Check that the solutions given by a snapshot are as good as the ones of
+// NumbersSolve
+static uint32_t SnapshotCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+
+        // Take a snapshot of the operations of the tiles
+        NumbersSnapshotObject snapshotObject = NULL;
+        if (NumbersSnapshotInitialize (numbersObject, &tiles, &snapshotObject) != Success) {
+            CheckFailure ("Snapshot", target, &tiles);
+            ++failureCount;
+            continue;
+        }
+
+        // Solve the game for several targets and maximum complexities
+        int failure = 0;
+        for (uint32_t queryId = 0; queryId < 4 && !failure; ++queryId) {
+            uint16_t complexityMax = queryId ? RandomGetValue (randomObject) % 100 : UINT16_MAX;
+            uint32_t targetQuery = queryId ? 101 + (RandomGetValue (randomObject) % 899) : target;
+
+            uint16_t complexities[2] = {complexityMax, complexityMax};
+            uint8_t solutionOperations[2][NUMBERS_TILE_COUNT_MAX] = {{0}};
+            uint32_t results[2];
+            if (NumbersSolveSnapshot (snapshotObject, targetQuery, &complexities[0], solutionOperations[0], &results[0]) != Success
+                || NumbersSolve (numbersObject, targetQuery, &tiles, &complexities[1], solutionOperations[1], &results[1]) != Success
+                || !IsSolutionCorrect (targetQuery, &tiles, solutionOperations[0], results[0], results[1])
+                || complexities[0] != complexities[1]) {
+                failure = 1;
+            }
+        }
+        NumbersSnapshotShutdown (snapshotObject);
+        if (failure) {
+            CheckFailure ("Snapshot", target, &tiles);
+            ++failureCount;
+        }
+    }
+    return failureCount;
+}
+
+// Check that the solutions taken from a cache are as good as the ones of
+// NumbersSolve, and that they refer to the tiles given by the caller
+static uint32_t CacheCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+
+    // Initialize a cache, small enough for problems to get replaced
+    NumbersCacheObject cacheObject = NULL;
+    if (NumbersCacheInitialize (64, &cacheObject) != Success) {
+        puts ("Error: Could not initialize the cache.");
+        return 1;
+    }
+
+    // Solve each problem several times, shuffling its tiles
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+        uint16_t complexityMax = problemId & 1 ? RandomGetValue (randomObject) % 100 : UINT16_MAX;
+
+        uint16_t complexityReference = complexityMax;
+        uint8_t solutionOperationsReference[NUMBERS_TILE_COUNT_MAX] = {0};
+        uint32_t resultReference;
+        int failure = NumbersSolve (numbersObject, target, &tiles, &complexityReference, solutionOperationsReference, &resultReference) != Success;
+        for (uint32_t solveId = 0; solveId < 3 && !failure; ++solveId) {
+            NumbersShuffle (&tiles, randomObject);
+            uint16_t complexity = complexityMax;
+            uint8_t solutionOperations[NUMBERS_TILE_COUNT_MAX] = {0};
+            uint32_t result;
+            if (NumbersSolveCached (numbersObject, cacheObject, target, &tiles, &complexity, solutionOperations, &result) != Success
+                || !IsSolutionCorrect (target, &tiles, solutionOperations, result, resultReference)
+                || complexity != complexityReference) {
+                failure = 1;
+            }
+        }
+        if (failure) {
+            CheckFailure ("Cache", target, &tiles);
+            ++failureCount;
+        }
+    }
+
+    // Shut down the cache
+    NumbersCacheShutdown (cacheObject);
+    return failureCount;
+}
+
+// Check that searches within limits give the solution of NumbersSolve when
+// they complete, and valid solutions when they get interrupted
+static uint32_t LimitsCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+
+        // Solve the game without limits
+        uint16_t complexityReference = UINT16_MAX;
+        uint8_t solutionOperationsReference[NUMBERS_TILE_COUNT_MAX] = {0};
+        uint32_t resultReference;
+        int failure = NumbersSolve (numbersObject, target, &tiles, &complexityReference, solutionOperationsReference, &resultReference) != Success;
+
+        // Solve the game with no limit, with the search cancelled from the
+        // start, then with a random budget
+        volatile uint32_t cancel = 1;
+        NumbersLimits limits[3] = {
+            {.timeLimit = 0},
+            {.cancel = &cancel},
+            {.operationBudget = 1 + (RandomGetValue (randomObject) % 2000)}
+        };
+        for (uint32_t limitsId = 0; limitsId < 3 && !failure; ++limitsId) {
+            uint16_t complexity = UINT16_MAX;
+            uint8_t solutionOperations[NUMBERS_TILE_COUNT_MAX] = {0};
+            uint32_t result;
+            NumbersError error = NumbersSolveWithLimits (numbersObject, target, &tiles, &limits[limitsId], &complexity, solutionOperations, &result);
+            if (error == Success) {
+                failure = (limitsId == 1)
+                    || result != resultReference || complexity != complexityReference
+                    || memcmp (solutionOperations, solutionOperationsReference, tiles.count);
+            } else {
+                uint32_t bestResult;
+                failure = error != InterruptedError || limitsId == 0
+                    || NumbersValidate (target, &tiles, solutionOperations, &bestResult, NULL) != Success
+                    || bestResult != result
+                    || TargetDiff (target, result) < TargetDiff (target, resultReference);
+            }
+        }
+        if (failure) {
+            CheckFailure ("Limits", target, &tiles);
+            ++failureCount;
+        }
+    }
+    return failureCount;
+}
+
+// Check that the objects of a pool can't be acquired twice, and that they get
+// the same solutions as NumbersSolve
+static uint32_t PoolCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+
+    // Initialize a pool of 2 objects
+    NumbersPoolObject poolObject = NULL;
+    NumbersOptions options = OptionsDefine (1);
+    if (NumbersPoolInitialize (&options, 2, &poolObject) != Success) {
+        puts ("Error: Could not initialize the pool.");
+        return 1;
+    }
+
+    // Solve each problem with one of the objects
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+
+        // Acquire all the objects
+        NumbersObject numbersObjects[3] = {NULL, NULL, NULL};
+        int failure = NumbersPoolAcquire (poolObject, &numbersObjects[0]) != Success
+            || NumbersPoolAcquire (poolObject, &numbersObjects[1]) != Success
+            || numbersObjects[0] == numbersObjects[1]
+            || NumbersPoolAcquire (poolObject, &numbersObjects[2]) != EmptyPoolError;
+
+        // Solve the game
+        if (!failure) {
+            failure = SolutionsCompare (numbersObject, numbersObjects[problemId & 1], target, &tiles);
+        }
+
+        // Release the objects (only once)
+        for (uint32_t objectId = 0; objectId < 2; ++objectId) {
+            if (numbersObjects[objectId] && NumbersPoolRelease (poolObject, numbersObjects[objectId]) != Success) {
+                failure = 1;
+            }
+        }
+        if (NumbersPoolRelease (poolObject, numbersObjects[0]) != IncorrectObjectError) {
+            failure = 1;
+        }
+        if (failure) {
+            CheckFailure ("Pool", target, &tiles);
+            ++failureCount;
+        }
+    }
+
+    // Shut down the pool
+    NumbersPoolShutdown (poolObject);
+    return failureCount;
+}
+
+// Check that the problems of a batch get the same solutions as with
+// NumbersSolve
+static uint32_t BatchCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+
+    // Initialize a batch object
+    NumbersBatchObject batchObject = NULL;
+    NumbersOptions options = OptionsDefine (1);
+    if (NumbersBatchInitialize (&options, 4, &batchObject) != Success) {
+        puts ("Error: Could not initialize the batch object.");
+        return 1;
+    }
+
+    // Solve the problems, a few at a time
+    uint32_t failureCount = 0;
+    for (uint32_t problemIdFirst = 0; problemIdFirst < problemCount; problemIdFirst += 16) {
+        uint32_t tileValues[16][24];
+        NumbersProblem problems[16];
+        NumbersError errors[16];
+        NumbersSolution solutions[16] = {{0}};
+        uint32_t batchProblemCount = problemCount - problemIdFirst < 16 ? problemCount - problemIdFirst : 16;
+        for (uint32_t problemId = 0; problemId < batchProblemCount; ++problemId) {
+            problems[problemId].target = ProblemDraw (randomObject, tileValues[problemId], &problems[problemId].tiles);
+            problems[problemId].complexity = problemId & 1 ? RandomGetValue (randomObject) % 100 : UINT16_MAX;
+        }
+        NumbersError errorBatch = NumbersSolveBatch (batchObject, batchProblemCount, problems, errors, solutions);
+
+        // Solve each problem on its own
+        for (uint32_t problemId = 0; problemId < batchProblemCount; ++problemId) {
+            NumbersProblem* problem = &problems[problemId];
+            uint16_t complexity = problem->complexity;
+            uint8_t solutionOperations[8] = {0};
+            uint32_t result;
+            NumbersError error = NumbersSolve (numbersObject, problem->target, &problem->tiles, &complexity, solutionOperations, &result);
+            if (errorBatch != Success || errors[problemId] != error
+                || solutions[problemId].result != result || solutions[problemId].complexity != complexity
+                || memcmp (solutions[problemId].solutionOperations, solutionOperations, problem->tiles.count)) {
+                CheckFailure ("Batch", problem->target, &problem->tiles);
+                ++failureCount;
+            }
+        }
+    }
+
+    // Shut down the batch object
+    NumbersBatchShutdown (batchObject);
+    return failureCount;
+}
+
+// Check that objects collecting statistics get the same solutions as the
+// others, and that their statistics are consistent
+static uint32_t StatisticsCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+
+    // Initialize an object collecting statistics
+    NumbersObject numbersObjects[2] = {numbersObject, NULL};
+    NumbersOptions options = OptionsDefine (1);
+    options.collectStatistics = 1;
+    if (NumbersInitializeWithOptions (&options, &numbersObjects[1]) != Success) {
+        puts ("Error: Could not initialize the solver.");
+        return 1;
+    }
+
+    // Solve random problems with both objects
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+        int failure = SolutionsCompare (numbersObjects[0], numbersObjects[1], target, &tiles);
+        NumbersStatistics statistics[2];
+        for (uint32_t objectId = 0; objectId < 2; ++objectId) {
+            NumbersGetStatistics (numbersObjects[objectId], &statistics[objectId]);
+        }
+
+        // The solutions shall be identical, all operations shall be counted
+        // in their layer, and only the second object shall count the
+        // duplicates
+        uint32_t operationCount = 0;
+        for (uint32_t layerId = 0; layerId < NUMBERS_TILE_COUNT_MAX; ++layerId) {
+            operationCount += statistics[1].operationCounts[layerId];
+        }
+        if (failure
+            || statistics[1].operationCounts[0] != tiles.count
+            || statistics[1].operationIdPeak != operationCount
+            || statistics[1].abortedTileCount
+            || (tiles.count > 2 && !statistics[1].duplicateHits && !statistics[1].duplicateMisses)
+            || statistics[0].duplicateHits || statistics[0].duplicateMisses) {
+            CheckFailure ("Statistics", target, &tiles);
+            ++failureCount;
+        }
+    }
+
+    // Shut down the object collecting statistics
+    NumbersShutdown (numbersObjects[1]);
+    return failureCount;
+}
+
+// Check that validating a batch of solutions gives the same errors and results
+// as validating each of them on its own
+static uint32_t ValidateBatchCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+
+        // Make up the solutions: the one of NumbersSolve, then random ones
+        // (most of them being invalid)
+        uint8_t solutionOperations[16][8] = {{0}};
+        uint32_t solutionCount = sizeof (solutionOperations) / sizeof (solutionOperations[0]);
+        uint16_t complexity = UINT16_MAX;
+        NumbersSolve (numbersObject, target, &tiles, &complexity, solutionOperations[0], NULL);
+        for (uint32_t solutionId = 1; solutionId < solutionCount; ++solutionId) {
+            uint32_t operationCount = RandomGetValue (randomObject) % tiles.count;
+            for (uint32_t operationId = 0; operationId < operationCount; ++operationId) {
+                uint32_t tileIdLeft = RandomGetValue (randomObject) % tiles.count;
+                uint32_t tileIdRight = RandomGetValue (randomObject) % tiles.count;
+                uint32_t op = RandomGetValue (randomObject) % 4;
+                solutionOperations[solutionId][operationId] = tileIdLeft | (tileIdRight << 3) | (op << 6);
+            }
+        }
+
+        // Validate the solutions
+        NumbersError errors[16];
+        uint32_t bestResults[16];
+        int failure = NumbersValidateBatch (target, &tiles, solutionCount, solutionOperations[0], errors, bestResults) != Success;
+        for (uint32_t solutionId = 0; solutionId < solutionCount && !failure; ++solutionId) {
+            uint32_t bestResult;
+            NumbersError error = NumbersValidate (target, &tiles, solutionOperations[solutionId], &bestResult, NULL);
+            if (errors[solutionId] != error || bestResults[solutionId] != bestResult) {
+                failure = 1;
+            }
+        }
+        if (failure) {
+            CheckFailure ("Validate batch", target, &tiles);
+            ++failureCount;
+        }
+    }
+    return failureCount;
+}
+
+// Get the distance between the target and the closest result that can be
+// reached from some values, by brute force (with 64-bit arithmetic, results
+// that don't fit in 32 bits being discarded)
+static uint64_t BruteForceTargetDiff (uint32_t target, uint32_t valueCount, uint64_t* values) {
+
+    // Check the values themselves
+    uint64_t targetDiff = UINT64_MAX;
+    for (uint32_t valueId = 0; valueId < valueCount; ++valueId) {
+        uint64_t valueTargetDiff = values[valueId] > target ? values[valueId] - target : target - values[valueId];
+        if (targetDiff > valueTargetDiff) {
+            targetDiff = valueTargetDiff;
+        }
+    }
+
+    // Combine each pair of values
+    for (uint32_t valueIdA = 0; valueIdA < valueCount; ++valueIdA) {
+        for (uint32_t valueIdB = valueIdA + 1; valueIdB < valueCount; ++valueIdB) {
+            uint64_t valueLarge = values[valueIdA] > values[valueIdB] ? values[valueIdA] : values[valueIdB];
+            uint64_t valueSmall = values[valueIdA] > values[valueIdB] ? values[valueIdB] : values[valueIdA];
+            uint64_t results[4] = {valueLarge + valueSmall, valueLarge - valueSmall, valueLarge * valueSmall, 0};
+            if (valueSmall && valueLarge % valueSmall == 0) {
+                results[3] = valueLarge / valueSmall;
+            }
+
+            // Replace the pair with each result
+            uint64_t valuesNext[valueCount];
+            uint32_t valueCountNext = 0;
+            for (uint32_t valueId = 0; valueId < valueCount; ++valueId) {
+                if (valueId != valueIdA && valueId != valueIdB) {
+                    valuesNext[valueCountNext++] = values[valueId];
+                }
+            }
+            for (uint32_t resultId = 0; resultId < 4; ++resultId) {
+                if (results[resultId] && results[resultId] <= UINT32_MAX) {
+                    valuesNext[valueCountNext] = results[resultId];
+                    uint64_t resultTargetDiff = BruteForceTargetDiff (target, valueCountNext + 1, valuesNext);
+                    if (targetDiff > resultTargetDiff) {
+                        targetDiff = resultTargetDiff;
+                    }
+                }
+            }
+        }
+    }
+    return targetDiff;
+}
+
+// Check that objects checking overflows get the same solutions as the others
+// in the standard game, and the best solutions when results get large
+static uint32_t OverflowCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+
+    // Initialize an object checking overflows
+    NumbersObject numbersObjects[2] = {numbersObject, NULL};
+    NumbersOptions options = OptionsDefine (1);
+    options.checkOverflow = 1;
+    if (NumbersInitializeWithOptions (&options, &numbersObjects[1]) != Success) {
+        puts ("Error: Could not initialize the solver.");
+        return 1;
+    }
+
+    // Solve random problems
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+        int failure = 0;
+        if (problemId & 1) {
+
+            // Solve a standard problem with both objects
+            failure = SolutionsCompare (numbersObjects[0], numbersObjects[1], target, &tiles);
+        } else {
+
+            // Make up a problem with large tiles (up to 5 of them, so that it
+            // can be solved by brute force) and a target anywhere
+            uint64_t values[5];
+            tiles.count = 2 + (RandomGetValue (randomObject) % 4);
+            for (uint32_t tileId = 0; tileId < tiles.count; ++tileId) {
+                tileValues[tileId] = RandomGetValue (randomObject) % 3 ? 1 + (RandomGetValue (randomObject) % 200000) : 1 + (RandomGetValue (randomObject) % 10);
+                values[tileId] = tileValues[tileId];
+            }
+            target = RandomGetValue (randomObject);
+
+            // Solve it with the object checking overflows
+            uint16_t complexity = UINT16_MAX;
+            uint8_t solutionOperations[NUMBERS_TILE_COUNT_MAX] = {0};
+            uint32_t result;
+            uint32_t bestResult;
+            failure = NumbersSolve (numbersObjects[1], target, &tiles, &complexity, solutionOperations, &result) != Success
+                || NumbersValidate (target, &tiles, solutionOperations, &bestResult, NULL) != Success
+                || bestResult != result
+                || TargetDiff (target, result) != BruteForceTargetDiff (target, tiles.count, values);
+        }
+        if (failure) {
+            CheckFailure ("Overflow", target, &tiles);
+            ++failureCount;
+        }
+    }
+
+    // Shut down the object checking overflows
+    NumbersShutdown (numbersObjects[1]);
+    return failureCount;
+}
+
+// Check that the best solutions validate to their own results, and that the
+// first one is as close to the target as the solution of NumbersSolve
+static uint32_t TopCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+
+        // Solve the game
+        uint16_t complexity = UINT16_MAX;
+        uint8_t solutionOperations[NUMBERS_TILE_COUNT_MAX] = {0};
+        uint32_t result;
+        NumbersError error = NumbersSolve (numbersObject, target, &tiles, &complexity, solutionOperations, &result);
+
+        // Get the best solutions
+        NumbersSolution solutions[20];
+        uint32_t solutionCount;
+        NumbersError errorTop = NumbersSolveTop (numbersObject, target, &tiles, UINT16_MAX, sizeof (solutions) / sizeof (solutions[0]), solutions, &solutionCount);
+        int failure = error != Success || errorTop != Success || !solutionCount
+            || TargetDiff (target, solutions[0].result) != TargetDiff (target, result);
+        for (uint32_t solutionId = 0; solutionId < solutionCount && !failure; ++solutionId) {
+            uint32_t bestResult;
+            if (NumbersValidate (target, &tiles, solutions[solutionId].solutionOperations, &bestResult, NULL) != Success
+                || bestResult != solutions[solutionId].result
+                || (solutionId && TargetDiff (target, solutions[solutionId - 1].result) > TargetDiff (target, bestResult))) {
+                failure = 1;
+            }
+        }
+        if (failure) {
+            CheckFailure ("Top", target, &tiles);
+            ++failureCount;
+        }
+    }
+    return failureCount;
+}
+
+// Check that the solutions of the Pareto frontier validate to their own
+// results, getting closer to the target as they get more complex, and that the
+// solution picked for a maximum complexity is as close to the target as the
+// one of NumbersSolve
+static uint32_t ParetoCheck (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+    uint32_t failureCount = 0;
+    for (uint32_t problemId = 0; problemId < problemCount; ++problemId) {
+        uint32_t tileValues[24];
+        NumbersTiles tiles;
+        uint32_t target = ProblemDraw (randomObject, tileValues, &tiles);
+
+        // Get the frontier
+        NumbersSolution solutions[64];
+        uint32_t solutionCount;
+        int failure = NumbersSolvePareto (numbersObject, target, &tiles, sizeof (solutions) / sizeof (solutions[0]), solutions, &solutionCount) != Success || !solutionCount;
+        for (uint32_t solutionId = 0; solutionId < solutionCount && !failure; ++solutionId) {
+            uint32_t bestResult;
+            if (NumbersValidate (target, &tiles, solutions[solutionId].solutionOperations, &bestResult, NULL) != Success
+                || bestResult != solutions[solutionId].result
+                || (solutionId && (solutions[solutionId - 1].complexity >= solutions[solutionId].complexity
+                    || TargetDiff (target, solutions[solutionId - 1].result) <= TargetDiff (target, bestResult)))) {
+                failure = 1;
+            }
+        }
+
+        // Pick solutions for several maximum complexities (the last one
+        // allowing any complexity)
+        for (uint32_t queryId = 0; queryId < 4 && !failure; ++queryId) {
+            uint16_t complexityMax = queryId < 3 ? RandomGetValue (randomObject) % 100 : UINT16_MAX;
+
+            uint16_t complexities[2] = {complexityMax, complexityMax};
+            uint8_t solutionOperations[2][NUMBERS_TILE_COUNT_MAX] = {{0}};
+            uint32_t results[2];
+            if (NumbersSelectPareto (solutionCount, solutions, &complexities[0], solutionOperations[0], &results[0]) != Success
+                || NumbersSolve (numbersObject, target, &tiles, &complexities[1], solutionOperations[1], &results[1]) != Success
+                || !IsSolutionCorrect (target, &tiles, solutionOperations[0], results[0], results[1])
+                || complexities[0] > complexityMax) {
+                failure = 1;
+            }
+        }
+        if (failure) {
+            CheckFailure ("Pareto", target, &tiles);
+            ++failureCount;
+        }
+    }
+    return failureCount;
+}
+
+// Check test
+static uint32_t CheckTest (NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount) {
+
+    // Run all the checks
+    const struct {
+        const char* name;
+        uint32_t (*function)(NumbersObject numbersObject, RandomObject randomObject, uint32_t problemCount);
+    } checks[] = {
+        {"Thread", ThreadCheck},
+        {"Range", RangeCheck},
+        {"Snapshot", SnapshotCheck},
+        {"Cache", CacheCheck},
+        {"Limits", LimitsCheck},
+        {"Batch", BatchCheck},
+        {"Pool", PoolCheck},
+        {"Statistics", StatisticsCheck},
+        {"Validate batch", ValidateBatchCheck},
+        {"Overflow", OverflowCheck},
+        {"Top", TopCheck},
+        {"Pareto", ParetoCheck},
+    };
+    uint32_t failureCount = 0;
+    for (uint32_t checkId = 0; checkId < sizeof (checks) / sizeof (checks[0]); ++checkId) {
+        uint32_t checkFailureCount = checks[checkId].function (numbersObject, randomObject, problemCount);
+        printf ("%s check: %u problem%s, %u failure%s\n",
+            checks[checkId].name,
+            problemCount, problemCount > 1 ? "s" : "",
+            checkFailureCount, checkFailureCount > 1 ? "s" : "");
+        failureCount += checkFailureCount;
+    }
+    return failureCount;
+}
+
 // Display the usage
 static void UsageDisplay (char* name) {
     printf ("Usage:\n"
         "%s -custom <target> <tile1> <tile2> <tile3> ...\n"
         "%s -unit\n"
         "%s -random [<tile count>]\n"
-        "%s -full [<tile count> [<target> | impossible]]\n",
-        name, name, name, name);
+        "%s -full [<tile count> [<target> | impossible]]\n"
+        "%s -check [<problem count>]\n",
+        name, name, name, name, name);
 }
 
 // Check the arguments
@@ -381,6 +1055,23 @@ static Test ArgumentsCheck (int argc, char** argv, uint32_t* target, NumbersTile
         return FULL_TEST;
     }
 
+    // Check test?
+    if (!strcmp (argv[1], "-check")) {
+        if (argc > 3) {
+            return ERROR;
+        }
+        if (argc == 2) {
+            tiles->count = 1000;
+        } else {
+            char* argEnd = NULL;
+            tiles->count = StringToNumber (argv[2], &argEnd);
+            if (*argEnd != '\0') {
+                return ERROR;
+            }
+        }
+        return CHECK_TEST;
+    }
+
     // Done
     return ERROR;
 }
@@ -397,9 +1088,11 @@ int main (int argc, char** argv) {
         return -1;
     }
 
-    // Initialize the solver
+    // Initialize the solver (letting its arrays grow, so that it never aborts
+    // its search)
     NumbersObject numbersObject = NULL;
-    NumbersError error = NumbersInitialize (25000, 15000, &numbersObject);
+    NumbersOptions options = OptionsDefine (1);
+    NumbersError error = NumbersInitializeWithOptions (&options, &numbersObject);
     if (error != Success) {
         puts ("Error: Could not initialize the solver.");
         return -1;
@@ -410,6 +1103,7 @@ int main (int argc, char** argv) {
     RandomSetSeed (randomObject, time (NULL));
 
     // Run the test
+    int status = 0;
     switch (test) {
         case CUSTOM_TEST:
             CustomTest (numbersObject, randomObject, target, &tiles);
@@ -423,6 +1117,11 @@ int main (int argc, char** argv) {
         case FULL_TEST:
             FullTest (numbersObject, randomObject, target, tiles.count);
             break;
+        case CHECK_TEST:
+            if (CheckTest (numbersObject, randomObject, tiles.count)) {
+                status = -1;
+            }
+            break;
         default:
             UsageDisplay (argv[0]);
             break;
@@ -438,5 +1137,5 @@ int main (int argc, char** argv) {
     free (tiles.values);
 
     // Done
-    return 0;
+    return status;
 }